@@ -0,0 +1,59 @@
+/*******************************************************
+ * @file CachedStartup.ino
+ *
+ * @brief Fast startup from a persistent device table cache.
+ *
+ * The first boot performs a full ROM search and stores the
+ * device table (ROMs, resolution, alarms, power mode) in
+ * EEPROM. Later boots only verify the cached devices with
+ * Match ROM reads and keep the stored enumeration order.
+ *
+ * Key features demonstrated:
+ * - DS18B20_EEPROMStore as cache backing store
+ * - Cached metadata via getDeviceInfo()
+ *
+ * @note This example requires the 7Semi DS18B20 library to be installed.
+ *
+ * @section author Author
+ * Written by 7Semi
+ *
+ * @section license License
+ * @license MIT
+ * Copyright (c) 2025 7Semi
+ *******************************************************/
+
+#include <7semi_DS18B20.h>
+#include <7semi_DS18B20_EEPROMStore.h>
+
+DS18B20_7semi sensor(2);    // data pin 2
+DS18B20_EEPROMStore store;  // cache at EEPROM address 0
+
+void setup() {
+  Serial.begin(115200);
+#if defined(ESP8266) || defined(ESP32)
+  EEPROM.begin(DS18B20_CACHE_SIZE);
+#endif
+  sensor.setCacheStore(&store);
+  if (!sensor.begin()) {
+    Serial.println("No DS18B20 found!");
+    while (1)
+      ;
+  }
+  DS18B20_DeviceInfo info;
+  for (uint8_t i = 0; sensor.getDeviceInfo(i, info); i++) {
+    Serial.print("Device ");
+    Serial.print(i);
+    Serial.print(": ");
+    Serial.print(info.resolution);
+    Serial.println(info.parasite ? " bit, parasite" : " bit, external");
+  }
+}
+
+void loop() {
+  uint8_t addr[8];
+  for (uint8_t i = 0; sensor.getAddress(i, addr); i++) {
+    Serial.print("Temp C: ");
+    Serial.println(sensor.readTemperature(addr));
+  }
+  delay(1000);
+}
@@ -0,0 +1,59 @@
+/*******************************************************
+ * @file DS2482Bridge.ino
+ *
+ * @brief DS18B20 sensors behind a DS2482-800 I2C-to-1-Wire bridge.
+ *
+ * The bridge times all 1-Wire slots in hardware, so interrupts
+ * stay enabled during bus transfers. Each of the 8 channels is
+ * an independent bus with its own device table.
+ *
+ * Key features demonstrated:
+ * - DS18B20_DS2482 transport (one object per channel)
+ * - DS18B20_Driver on a runtime-pluggable transport
+ *
+ * @note This example requires the 7Semi DS18B20 library to be installed.
+ *
+ * @section author Author
+ * Written by 7Semi
+ *
+ * @section license License
+ * @license MIT
+ * Copyright (c) 2025 7Semi
+ *******************************************************/
+
+#include <7semi_DS18B20.h>
+#include <7semi_DS18B20_DS2482.h>
+
+#define CHANNELS 2  // up to 8 on the DS2482-800; use channel -1 on the DS2482-100
+
+DS18B20_DS2482 bridge0(Wire, 0x18, 0);
+DS18B20_DS2482 bridge1(Wire, 0x18, 1);
+DS18B20_Driver<DS18B20_Transport> bus0(bridge0);
+DS18B20_Driver<DS18B20_Transport> bus1(bridge1);
+DS18B20_Driver<DS18B20_Transport> *buses[CHANNELS] = { &bus0, &bus1 };
+
+void setup() {
+  Serial.begin(115200);
+  Wire.begin();
+  if (!bridge0.begin()) {
+    Serial.println("DS2482 not found!");
+    while (1)
+      ;
+  }
+  for (uint8_t c = 0; c < CHANNELS; c++) {
+    buses[c]->begin();
+  }
+}
+
+void loop() {
+  uint8_t addr[8];
+  for (uint8_t c = 0; c < CHANNELS; c++) {
+    for (uint8_t i = 0; buses[c]->getAddress(i, addr); i++) {
+      Serial.print("Channel ");
+      Serial.print(c);
+      Serial.print(" temp C: ");
+      Serial.println(buses[c]->readTemperature(addr));
+    }
+  }
+  delay(1000);
+}
@@ -0,0 +1,58 @@
+/*******************************************************
+ * @file Events.ino
+ *
+ * @brief Event-driven readings from the sweep scheduler.
+ *
+ * poll() reads every sensor once a second (the first one
+ * every 250 ms) without blocking loop() and delivers the
+ * results to a registered callback. Sensors due together
+ * share one broadcast conversion. Every 10th sweep a ROM
+ * search reports sensors that were plugged in or removed.
+ *
+ * Key features demonstrated:
+ * - onEvent() with a DS18B20_EVENT_* mask
+ * - setSweepInterval() / setSchedule() / setRescanInterval() / poll()
+ *
+ * @note This example requires the 7Semi DS18B20 library to be installed.
+ *
+ * @section author Author
+ * Written by 7Semi
+ *
+ * @section license License
+ * @license MIT
+ * Copyright (c) 2025 7Semi
+ *******************************************************/
+
+#include <7semi_DS18B20.h>
+
+DS18B20_7semi sensor(2);  // data pin 2
+
+void onSensorEvent(const DS18B20_Event &event, void *ctx) {
+  (void)ctx;
+  Serial.print("Device ");
+  Serial.print(event.index);
+  switch (event.type) {
+    case DS18B20_EVENT_READING:
+      Serial.print(" Temp C: ");
+      Serial.println(event.raw / 16.0f);
+      break;
+    case DS18B20_EVENT_ALARM: Serial.println(" alarm"); break;
+    case DS18B20_EVENT_ERROR: Serial.println(" read error"); break;
+    case DS18B20_EVENT_ADDED: Serial.println(" added"); break;
+    case DS18B20_EVENT_REMOVED: Serial.println(" removed"); break;
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  sensor.begin();
+  sensor.onEvent(DS18B20_EVENT_ALL, onSensorEvent);
+  sensor.setSweepInterval(1000);
+  sensor.setSchedule(0, 250, 1);  // fast sensor, read first when sharing a conversion
+  sensor.setRescanInterval(10);
+}
+
+void loop() {
+  sensor.poll();
+  // other work runs here
+}
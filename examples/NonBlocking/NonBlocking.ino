@@ -0,0 +1,55 @@
+/*******************************************************
+ * @file NonBlocking.ino
+ *
+ * @brief Non-blocking conversion with parasite-powered sensors.
+ *
+ * A broadcast Convert T is started and loop() keeps running
+ * while the sensors convert. The strong pull-up MOSFET on
+ * pin 3 is switched on right after the command and released
+ * when the conversion time has passed - either from loop()
+ * via isConversionComplete() or from a timer interrupt
+ * calling servicePullup().
+ *
+ * Key features demonstrated:
+ * - startConversionAll() / isConversionComplete()
+ * - Reading results with readRawTemperature()
+ *
+ * @note This example requires the 7Semi DS18B20 library to be installed.
+ *
+ * @section author Author
+ * Written by 7Semi
+ *
+ * @section license License
+ * @license MIT
+ * Copyright (c) 2025 7Semi
+ *******************************************************/
+
+#include <7semi_DS18B20.h>
+
+DS18B20_7semi sensor(2, 3);  // data pin 2, strong pull-up pin 3
+bool converting = false;
+
+void setup() {
+  Serial.begin(115200);
+  if (!sensor.begin()) {
+    Serial.println("No DS18B20 found!");
+    while (1)
+      ;
+  }
+}
+
+void loop() {
+  if (!converting) {
+    converting = sensor.startConversionAll();
+  } else if (sensor.isConversionComplete()) {
+    converting = false;
+    uint8_t addr[8];
+    int16_t raw;
+    for (uint8_t i = 0; sensor.getAddress(i, addr); i++) {
+      if (!sensor.readRawTemperature(addr, raw)) continue;
+      Serial.print("Temp C: ");
+      Serial.println(raw / 16.0f);
+    }
+  }
+  // other work runs here while the sensors convert
+}
@@ -0,0 +1,111 @@
+/***************************************************************************************************
+//  check_abort.cpp - host check of the early abort of impossible scratchpad reads
+//  Written for the 7semi sensor platform
+//
+//  A scratchpad with a valid CRC but an impossible config byte (or byte 5 not 0xFF) is rejected.
+//  The bit-level transport stops reading at that byte (fewer time slots than a full read); the
+//  UART reads all 9 bytes in its one transfer and applies the same verdict with checkRead(). Both
+//  return the same bytes and count the read once, as a sentinel.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_abort.cpp ../../src/7semi_*.cpp -o check_abort
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+#include "7semi_DS18B20_UARTSim.h"
+
+// corrupt(): set scratchpad byte 'pos' of device 'index' and seal it with a matching CRC
+static void corrupt(DS18B20_SimBus &sim, uint8_t index, uint8_t pos, uint8_t value) {
+  uint8_t *sp = sim.device(index).scratchpad;
+  sp[pos] = value;
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < 8; i++) crc = DS18B20_Script::crcUpdate(crc, sp[i]);
+  sp[8] = crc;
+}
+
+// abortedRead(): one rejected read on both transports; returns the bit-level slots saved
+template <class Driver, class UartDriver>
+static uint32_t abortedRead(DS18B20_SimBus &sim, Driver &driver, UartDriver &uartDriver, DS18B20_UARTBusT<DS18B20_UARTSim> &uart, const uint8_t rom[8], uint32_t fullSlots) {
+  // the verdict on the raw bytes, as a one-piece transport sees them
+  uint8_t rx[10];
+  memcpy(rx, sim.device(0).scratchpad, 9);
+  DS18B20_Script::checkRead(rx);
+  HOST_CHECK(rx[9] == DS18B20_CHECK_ABORTED);
+
+  uint8_t sp[9];
+  DS18B20_Health before = hostCheckHealth(driver, rom);
+  uint32_t slots = sim.slots;
+  HOST_CHECK(!driver.readScratchpad(rom, sp));
+  slots = sim.slots - slots;
+  HOST_CHECK(slots < fullSlots);
+  HOST_CHECK(memcmp(sp, rx, 9) == 0);
+  DS18B20_Health after = hostCheckHealth(driver, rom);
+  HOST_CHECK(after.sentinels == before.sentinels + 1);
+  HOST_CHECK(after.crcErrors == before.crcErrors && after.noPresence == before.noPresence);
+
+  uint8_t usp[9];
+  before = hostCheckHealth(uartDriver, rom);
+  uint32_t transfers = uart.transfers();
+  HOST_CHECK(!uartDriver.readScratchpad(rom, usp));
+  HOST_CHECK(uart.transfers() - transfers == 1);
+  HOST_CHECK(memcmp(usp, sp, 9) == 0);
+  after = hostCheckHealth(uartDriver, rom);
+  HOST_CHECK(after.sentinels == before.sentinels + 1);
+  HOST_CHECK(after.crcErrors == before.crcErrors && after.noPresence == before.noPresence);
+  return fullSlots - slots;
+}
+
+int main() {
+  DS18B20_SimBus sim;
+  sim.addDevice(0xAB0000, false);
+  sim.addDevice(0xAB0101, false);
+  uint8_t rom[8];
+  memcpy(rom, sim.device(0).rom, 8);
+
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  HOST_CHECK(driver.begin());
+  DS18B20_UARTSim port(sim);
+  DS18B20_UARTBusT<DS18B20_UARTSim> uart(port);
+  uart.begin();
+  DS18B20_Driver<DS18B20_Transport> uartDriver(uart);
+  HOST_CHECK(uartDriver.begin());
+
+  // a valid scratchpad: the full read, the reference slot count
+  uint8_t sp[9];
+  uint32_t slots = sim.slots;
+  HOST_CHECK(driver.readScratchpad(rom, sp));
+  uint32_t fullSlots = sim.slots - slots;
+  uint8_t rx[10];
+  memcpy(rx, sp, 9);
+  DS18B20_Script::checkRead(rx);
+  HOST_CHECK(rx[9] == DS18B20_CHECK_OK);
+
+  // impossible config byte: stops after byte 4, the last 4 bytes (32 slots) are not read
+  uint8_t saved[9];
+  memcpy(saved, sim.device(0).scratchpad, 9);
+  corrupt(sim, 0, 4, 0x00);
+  HOST_CHECK(abortedRead(sim, driver, uartDriver, uart, rom, fullSlots) == 4 * 8);
+
+  // reserved byte 5 not 0xFF: stops after byte 5
+  memcpy(sim.device(0).scratchpad, saved, 9);
+  corrupt(sim, 0, 5, 0x00);
+  HOST_CHECK(abortedRead(sim, driver, uartDriver, uart, rom, fullSlots) == 3 * 8);
+
+  // a plain CRC error is read to the end on both transports
+  memcpy(sim.device(0).scratchpad, saved, 9);
+  sim.device(0).scratchpad[0] ^= 0x08;
+  DS18B20_Health before = hostCheckHealth(driver, rom);
+  slots = sim.slots;
+  hostCheckCrcFailure(driver, rom, before);
+  HOST_CHECK(sim.slots - slots == fullSlots);
+  before = hostCheckHealth(uartDriver, rom);
+  hostCheckCrcFailure(uartDriver, rom, before);
+
+  memcpy(sim.device(0).scratchpad, saved, 9);
+  HOST_CHECK(driver.readScratchpad(rom, sp) && uartDriver.readScratchpad(rom, sp));
+  return hostCheckResult("Abort");
+}
@@ -0,0 +1,120 @@
+/***************************************************************************************************
+//  check_cache.cpp - host check of the persistent device table cache
+//  Written for the 7semi sensor platform
+//
+//  begin() with a cache store: the first start searches and saves the table, the next start
+//  restores it with Match ROM reads only (no ROM search), and a corrupt cache or a cached
+//  device that no longer answers falls back to the full search and rewrites the cache.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_cache.cpp ../../src/7semi_*.cpp -o check_cache
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+// SearchCountBus: DS18B20_SimBus counting ROM search passes
+class SearchCountBus : public DS18B20_SimBus {
+public:
+  SearchCountBus()
+    : searches(0) {}
+
+  void resetSearch() override {
+    searches++;
+    DS18B20_SimBus::resetSearch();
+  }
+
+  uint32_t searches;
+};
+
+// RamStore: cache store in a byte array, as an EEPROM or file store would hold it
+class RamStore : public DS18B20_CacheStore {
+public:
+  RamStore() { memset(data, 0xFF, sizeof(data)); }
+
+  bool read(uint16_t offset, uint8_t *buf, uint16_t len) override {
+    if (offset + len > sizeof(data)) return false;
+    memcpy(buf, &data[offset], len);
+    return true;
+  }
+
+  bool write(uint16_t offset, const uint8_t *buf, uint16_t len) override {
+    if (offset + len > sizeof(data)) return false;
+    memcpy(&data[offset], buf, len);
+    return true;
+  }
+
+  uint8_t data[DS18B20_CACHE_SIZE];
+};
+
+int main() {
+  SearchCountBus sim;
+  HostCheckSensor sensors[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    sim.addDevice(0xCAC000 + i * 0x77, false);
+    sensors[i].celsius = 30.0f - i * 4.5f;
+    sim.setTemperature(i, sensors[i].celsius);
+    memcpy(sensors[i].rom, sim.device(i).rom, 8);
+  }
+  RamStore store;
+
+  // empty store: full search, table saved
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    driver.setCacheStore(&store);
+    HOST_CHECK(driver.begin());
+    HOST_CHECK(sim.searches > 0);
+    HOST_CHECK(store.data[0] == DS18B20_CACHE_MAGIC);
+    HOST_CHECK(driver.setResolution(sensors[1].rom, 10, true));
+  }
+
+  // next start: the device table comes from the cache, verified without a search
+  uint32_t searches = sim.searches;
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    driver.setCacheStore(&store);
+    HOST_CHECK(driver.begin());
+    HOST_CHECK(sim.searches == searches);
+    hostCheckReadings(driver, sensors, 3);
+    DS18B20_DeviceInfo info;
+    HOST_CHECK(driver.getDeviceInfo((uint8_t)driver.indexOf(sensors[1].rom), info) && info.resolution == 10);
+  }
+
+  // corrupt cache: CRC trailer mismatch, search again and rewrite the cache
+  store.data[DS18B20_CACHE_HEADER_SIZE + 2] ^= 0x10;
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    driver.setCacheStore(&store);
+    HOST_CHECK(driver.begin());
+    HOST_CHECK(sim.searches > searches);
+    hostCheckReadings(driver, sensors, 3);
+  }
+  searches = sim.searches;
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    driver.setCacheStore(&store);
+    HOST_CHECK(driver.loadCache());
+    HOST_CHECK(driver.getDeviceCount() == 3);
+  }
+
+  // a cached sensor is gone: verification fails, the search rebuilds a two-device table
+  sim.setConnected(2, false);
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    driver.setCacheStore(&store);
+    HOST_CHECK(driver.begin());
+    HOST_CHECK(sim.searches > searches);
+    hostCheckReadings(driver, sensors, 2);
+    HOST_CHECK(driver.indexOf(sensors[2].rom) < 0);
+  }
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    driver.setCacheStore(&store);
+    HOST_CHECK(driver.loadCache());
+    HOST_CHECK(driver.getDeviceCount() == 2);
+  }
+  return hostCheckResult("Cache");
+}
@@ -0,0 +1,61 @@
+/***************************************************************************************************
+//  check_ds2482.cpp - host check of DS18B20_Driver behind the DS2482-800 register model
+//  Written for the 7semi sensor platform
+//
+//  Two channels of one DS18B20_DS2482Sim, each wired to its own DS18B20_SimBus, with status
+//  polls reporting 1WB busy so the transport's wait loop is exercised as well.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_ds2482.cpp ../../src/7semi_*.cpp -o check_ds2482
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+#include "7semi_DS18B20_DS2482Sim.h"
+
+int main() {
+  DS18B20_SimBus wire0, wire5;
+  HostCheckSensor sensors0[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    wire0.addDevice(0x482000 + i * 0x0B1, false);
+    sensors0[i].celsius = 18.0f + i * 0.5f;
+    wire0.setTemperature(i, sensors0[i].celsius);
+    memcpy(sensors0[i].rom, wire0.device(i).rom, 8);
+  }
+  HostCheckSensor sensor5;
+  wire5.addDevice(0x482555, true);
+  sensor5.celsius = -22.125f;
+  wire5.setTemperature(0, sensor5.celsius);
+  memcpy(sensor5.rom, wire5.device(0).rom, 8);
+
+  DS18B20_DS2482Sim chip;
+  chip.attach(0, &wire0);
+  chip.attach(5, &wire5);
+  chip.setBusyPolls(2);
+  DS18B20_DS2482T<DS18B20_DS2482Sim> ch0(chip, 0x18, 0), ch5(chip, 0x18, 5);
+  HOST_CHECK(ch0.begin());
+  HOST_CHECK(ch5.begin());
+
+  DS18B20_Driver<DS18B20_Transport> bus0(ch0), bus5(ch5);
+  HOST_CHECK(bus0.begin());
+  HOST_CHECK(bus5.begin());
+  hostCheckReadings(bus0, sensors0, 3);
+  hostCheckReadings(bus5, &sensor5, 1);
+  HOST_CHECK(bus5.isParasitePower(sensor5.rom));
+
+  DS18B20_Health before = hostCheckHealth(bus0, sensors0[0].rom);
+  wire0.device(0).scratchpad[3] ^= 0x40;  // TL changed without a new CRC
+  hostCheckCrcFailure(bus0, sensors0[0].rom, before);
+
+  // the only sensor on channel 5 gone: the bridge reports no presence pulse
+  before = hostCheckHealth(bus5, sensor5.rom);
+  wire5.setConnected(0, false);
+  hostCheckMissing(bus5, sensor5.rom, before, true);
+
+  // channel 0 keeps working
+  HOST_CHECK(fabs(bus0.readTemperature(sensors0[2].rom) - sensors0[2].celsius) < 0.01f);
+  return hostCheckResult("DS2482");
+}
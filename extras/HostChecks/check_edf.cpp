@@ -0,0 +1,131 @@
+/***************************************************************************************************
+//  check_edf.cpp - host check of poll()'s earliest-deadline-first grouping and priorities
+//  Written for the 7semi sensor platform
+//
+//  Two sensors with the same period: with deadlines 40 ms apart (inside one 9-bit conversion)
+//  every conversion is a shared Skip ROM Convert T and the higher priority is read first; with
+//  deadlines 150 ms apart each converts by itself (Match ROM). Runs in real time (~2 s).
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_edf.cpp ../../src/7semi_*.cpp -o check_edf
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+// ConvertCountBus: DS18B20_SimBus counting Convert T commands by addressing mode
+class ConvertCountBus : public DS18B20_SimBus {
+public:
+  ConvertCountBus()
+    : broadcasts(0), matched(0), _skipped(false) {}
+
+  void skip() override {
+    _skipped = true;
+    DS18B20_SimBus::skip();
+  }
+
+  void select(const uint8_t rom[8]) override {
+    _skipped = false;
+    DS18B20_SimBus::select(rom);
+  }
+
+  void write(uint8_t v, uint8_t power = 0) override {
+    if (v == 0x44) (_skipped ? broadcasts : matched)++;
+    DS18B20_SimBus::write(v, power);
+  }
+
+  uint32_t conversions() const { return broadcasts + matched; }
+
+  uint32_t broadcasts;
+  uint32_t matched;
+
+private:
+  bool _skipped;
+};
+
+struct ReadingLog {
+  ConvertCountBus *bus;
+  uint16_t readings[4];
+  uint32_t conversion[4];  // conversion count at each device's last reading
+  uint16_t shared;         // device 0 read after device 1 within one conversion
+  uint16_t inverted;       // device 1 read after device 0 within one conversion
+};
+
+static void onReading(const DS18B20_Event &event, void *ctx) {
+  ReadingLog &log = *(ReadingLog *)ctx;
+  uint8_t i = event.index;
+  if (i >= 4) return;
+  log.readings[i]++;
+  log.conversion[i] = log.bus->conversions();
+  if (i == 0 && log.conversion[1] == log.conversion[0]) log.shared++;
+  if (i == 1 && log.conversion[0] == log.conversion[1]) log.inverted++;
+}
+
+// noConvertByte(): a ROM containing 0x44 would be counted as a conversion
+static bool noConvertByte(const uint8_t rom[8]) {
+  for (uint8_t i = 0; i < 8; i++) {
+    if (rom[i] == 0x44) return false;
+  }
+  return true;
+}
+
+// run(): schedule devices 0 and 1 with 'period', 'offset' ms apart, and poll for 'ms'
+template <class Driver>
+static void run(Driver &driver, ConvertCountBus &sim, ReadingLog &log, uint32_t period, uint32_t offset, uint32_t ms) {
+  // let a conversion still running from the previous run finish unlogged
+  driver.setSchedule(0, DS18B20_SCHEDULE_OFF);
+  driver.setSchedule(1, DS18B20_SCHEDULE_OFF);
+  uint32_t start = millis();
+  while (millis() - start < 200) {
+    driver.poll();
+    delay(1);
+  }
+  memset(&log, 0, sizeof(log));
+  log.bus = &sim;
+  for (uint8_t i = 0; i < 4; i++) log.conversion[i] = 0xFFFFFFFFUL;
+  driver.setSchedule(0, period, 1);
+  delay(offset);
+  driver.setSchedule(1, period, 5);
+  sim.broadcasts = sim.matched = 0;
+  start = millis();
+  while (millis() - start < ms) {
+    driver.poll();
+    delay(1);
+  }
+}
+
+int main() {
+  ConvertCountBus sim;
+  for (uint8_t i = 0; i < 4; i++) {
+    sim.addDevice(0xEDF000 + i * 0x0123, false);
+    sim.setTemperature(i, 18.0f + i);
+    HOST_CHECK(noConvertByte(sim.device(i).rom));
+  }
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  HOST_CHECK(driver.begin());
+  uint8_t rom[8];
+  for (uint8_t i = 0; driver.getAddress(i, rom); i++) HOST_CHECK(driver.setResolution(rom, 9));
+  driver.setSchedule(2, DS18B20_SCHEDULE_OFF);
+  driver.setSchedule(3, DS18B20_SCHEDULE_OFF);
+  ReadingLog log;
+  driver.onEvent(DS18B20_EVENT_READING, onReading, &log);
+
+  // deadlines 40 ms apart: device 1 joins device 0's conversion every time, and is read first
+  run(driver, sim, log, 200, 40, 1000);
+  HOST_CHECK(log.readings[0] >= 4 && log.readings[1] >= 4);
+  HOST_CHECK(log.readings[2] == 0 && log.readings[3] == 0);
+  HOST_CHECK(sim.matched == 0);
+  HOST_CHECK(sim.broadcasts <= log.readings[0] + 1u);
+  HOST_CHECK(log.shared + 1u >= log.readings[0]);
+  HOST_CHECK(log.inverted == 0);
+
+  // deadlines 150 ms apart: too far to share, each device converts alone
+  run(driver, sim, log, 300, 150, 1000);
+  HOST_CHECK(log.readings[0] >= 3 && log.readings[1] >= 3);
+  HOST_CHECK(sim.broadcasts <= 1);  // the first poll finds both overdue
+  HOST_CHECK(sim.matched + 2 * sim.broadcasts >= (uint32_t)log.readings[0] + log.readings[1]);
+  return hostCheckResult("EDF");
+}
@@ -0,0 +1,103 @@
+/***************************************************************************************************
+//  check_filter.cpp - host check of the per-device filter stage
+//  Written for the 7semi sensor platform
+//
+//  DS18B20_Filter on its own (spike rejector, median, EMA on raw 1/16 °C values), then through
+//  poll(): a jump beyond maxDelta arrives as a SPIKE error instead of a reading, and a full
+//  searchDevices() clears the configuration again.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_filter.cpp ../../src/7semi_*.cpp -o check_filter
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+// feed(): one sample through the filter; returns the output, or -32768 if it was dropped
+static int16_t feed(DS18B20_Filter &filter, int16_t raw) {
+  return filter.apply(raw) ? raw : (int16_t)-32768;
+}
+
+struct EventLog {
+  uint16_t readings;
+  uint16_t spikes;
+  int16_t raw;
+};
+
+static void onEvent(const DS18B20_Event &event, void *ctx) {
+  EventLog &log = *(EventLog *)ctx;
+  if (event.type == DS18B20_EVENT_READING) {
+    log.readings++;
+    log.raw = event.raw;
+  }
+  if (event.type == DS18B20_EVENT_ERROR && event.status == DS18B20_STATUS_SPIKE) log.spikes++;
+}
+
+// sweep(): poll() until one reading or error of device 0 arrived
+template <class Driver>
+static void sweep(Driver &driver, EventLog &log) {
+  uint16_t seen = log.readings + log.spikes;
+  uint32_t start = millis();
+  while (log.readings + log.spikes == seen && millis() - start < 2000) {
+    driver.poll();
+    delay(1);
+  }
+}
+
+int main() {
+  DS18B20_Filter filter;
+
+  // spike rejector: single outliers dropped, a level held for DS18B20_FILTER_MAX_REJECTS accepted
+  filter.configure(DS18B20_FILTER_SPIKE, 0, 32);
+  HOST_CHECK(feed(filter, 400) == 400);
+  HOST_CHECK(feed(filter, 420) == 420);
+  HOST_CHECK(feed(filter, 900) == -32768);
+  HOST_CHECK(feed(filter, 430) == 430);
+  for (uint8_t i = 1; i < DS18B20_FILTER_MAX_REJECTS; i++) HOST_CHECK(feed(filter, 900) == -32768);
+  HOST_CHECK(feed(filter, 900) == 900);
+
+  // median of 3 over the accepted samples
+  filter.configure(DS18B20_FILTER_MEDIAN3, 0, 0);
+  feed(filter, 400);
+  feed(filter, 800);
+  HOST_CHECK(feed(filter, 404) == 404);
+  HOST_CHECK(feed(filter, 402) == 404);
+
+  // EMA, alpha 1/2 in Q8, seeded with the first sample
+  filter.configure(DS18B20_FILTER_EMA, 128, 0);
+  HOST_CHECK(feed(filter, 400) == 400);
+  HOST_CHECK(feed(filter, 432) == 416);
+  HOST_CHECK(feed(filter, 432) == 424);
+
+  // through poll(): one sensor, sampled every sweep
+  DS18B20_SimBus sim;
+  sim.addDevice(0x39F000, false);
+  sim.setTemperature(0, 22.0f);
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  HOST_CHECK(driver.begin());
+  uint8_t rom[8];
+  HOST_CHECK(driver.getAddress(0, rom) && driver.setResolution(rom, 9));
+  driver.setSweepInterval(100);
+  EventLog log;
+  memset(&log, 0, sizeof(log));
+  driver.onEvent(DS18B20_EVENT_ALL, onEvent, &log);
+
+  HOST_CHECK(driver.setFilter(0, DS18B20_FILTER_SPIKE, 0, 16));  // 1 °C
+  sweep(driver, log);
+  HOST_CHECK(log.readings == 1 && log.raw == 22 * 16);
+  sim.setTemperature(0, 40.0f);
+  sweep(driver, log);
+  HOST_CHECK(log.spikes == 1 && log.readings == 1);
+
+  // a full search starts every device without a filter
+  driver.searchDevices();
+  sweep(driver, log);
+  HOST_CHECK(log.spikes == 1 && log.readings == 2 && log.raw == 40 * 16);
+  sim.setTemperature(0, 10.0f);
+  sweep(driver, log);
+  HOST_CHECK(log.spikes == 1 && log.readings == 3 && log.raw == 10 * 16);
+  return hostCheckResult("Filter");
+}
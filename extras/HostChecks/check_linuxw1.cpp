@@ -0,0 +1,149 @@
+/***************************************************************************************************
+//  check_linuxw1.cpp - host check of DS18B20_Driver on the Linux w1 (sysfs) transport
+//  Written for the 7semi sensor platform
+//
+//  Builds a fake /sys/bus/w1/devices tree in a temporary directory (one bus master, 28-* slave
+//  directories with w1_slave, alarms, resolution, eeprom_cmd and ext_power) and points
+//  DS18B20_LinuxW1Bus at it. A corrupted w1_slave line stands in for a CRC failure, a removed
+//  slave directory for a sensor the kernel dropped.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_linuxw1.cpp ../../src/7semi_*.cpp -o check_linuxw1
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_LinuxW1.h"
+
+#if defined(__linux__)
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char *const attrs[] = { "w1_slave", "alarms", "resolution", "eeprom_cmd", "ext_power" };
+
+static void writeFile(const char *dir, const char *name, const char *text) {
+  char path[300];
+  snprintf(path, sizeof(path), "%s/%s", dir, name);
+  FILE *f = fopen(path, "w");  // truncates in place, so pre-opened descriptors see the change
+  if (!f) return;
+  fputs(text, f);
+  fclose(f);
+}
+
+// slaveDir(): "<root>/28-<serial bytes 6..1 as hex>"
+static void slaveDir(char *out, size_t size, const char *root, const uint8_t rom[8]) {
+  snprintf(out, size, "%s/28-%02x%02x%02x%02x%02x%02x", root, rom[6], rom[5], rom[4], rom[3], rom[2], rom[1]);
+}
+
+// writeScratchpad(): w1_therm's two-line w1_slave format; 'crcDelta' corrupts the CRC byte
+static void writeScratchpad(const char *dir, float celsius, uint8_t crcDelta) {
+  int16_t raw = (int16_t)(celsius * 16.0f);
+  uint8_t sp[9] = { (uint8_t)raw, (uint8_t)(raw >> 8), 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10, 0 };
+  sp[8] = (uint8_t)(DS18B20_Common::crc8(sp, 8) ^ crcDelta);
+  char hex[32];
+  char *p = hex;
+  for (uint8_t i = 0; i < 9; i++) p += sprintf(p, "%02x ", sp[i]);
+  char text[128];
+  snprintf(text, sizeof(text), "%s: crc=%02x %s\n%st=%d\n", hex, sp[8], crcDelta ? "NO" : "YES", hex, (int)(celsius * 1000.0f));
+  writeFile(dir, "w1_slave", text);
+}
+
+static void addSlave(const char *root, HostCheckSensor &sensor, uint64_t serial) {
+  sensor.rom[0] = 0x28;
+  for (uint8_t i = 1; i < 7; i++) {
+    sensor.rom[i] = (uint8_t)serial;
+    serial >>= 8;
+  }
+  sensor.rom[7] = DS18B20_Common::crc8(sensor.rom, 7);
+  char dir[256];
+  slaveDir(dir, sizeof(dir), root, sensor.rom);
+  mkdir(dir, 0755);
+  writeScratchpad(dir, sensor.celsius, 0);
+  writeFile(dir, "alarms", "70 75\n");
+  writeFile(dir, "resolution", "12\n");
+  writeFile(dir, "eeprom_cmd", "");
+  writeFile(dir, "ext_power", "1\n");
+}
+
+static void removeSlave(const char *root, const uint8_t rom[8]) {
+  char dir[256];
+  char path[300];
+  slaveDir(dir, sizeof(dir), root, rom);
+  for (uint8_t i = 0; i < sizeof(attrs) / sizeof(attrs[0]); i++) {
+    snprintf(path, sizeof(path), "%s/%s", dir, attrs[i]);
+    unlink(path);
+  }
+  rmdir(dir);
+}
+
+int main() {
+  char root[] = "/tmp/ds18b20_w1_XXXXXX";
+  if (!mkdtemp(root)) {
+    perror("mkdtemp");
+    return 2;
+  }
+  char master[256];
+  snprintf(master, sizeof(master), "%s/w1_bus_master1", root);
+  mkdir(master, 0755);
+  writeFile(master, "therm_bulk_read", "");
+
+  HostCheckSensor sensors[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    sensors[i].celsius = 21.5f + i * 1.25f;
+    addSlave(root, sensors[i], 0x00000A1B2C00ULL + i * 0x3301);
+  }
+
+  {
+    DS18B20_LinuxW1Bus w1(root);
+    DS18B20_Driver<DS18B20_Transport> driver(w1);
+    HOST_CHECK(driver.begin());
+    HOST_CHECK(!driver.hasParasiteDevices());
+    hostCheckReadings(driver, sensors, 3);
+    HOST_CHECK(driver.verifyPresence(sensors[1].rom));
+
+    // a traced w1 bus still runs each script through the decoder in one go
+    DS18B20_Trace trace;
+    DS18B20_TraceBusT<DS18B20_Transport> traced(w1, trace);
+    DS18B20_Driver<DS18B20_Transport> tracedDriver(traced);
+    HOST_CHECK(tracedDriver.begin());
+    trace.clear();
+    HOST_CHECK(fabs(tracedDriver.readTemperature(sensors[1].rom) - sensors[1].celsius) < 0.01f);
+    DS18B20_TraceEvent event;
+    HOST_CHECK(trace.get(0, event) && event.type == DS18B20_TRACE_SCRIPT && event.value == 1);
+
+    char dir[256];
+    slaveDir(dir, sizeof(dir), root, sensors[0].rom);
+    DS18B20_Health before = hostCheckHealth(driver, sensors[0].rom);
+    writeScratchpad(dir, sensors[0].celsius, 0x5A);
+    hostCheckCrcFailure(driver, sensors[0].rom, before);
+
+    // the kernel dropped the slave: its directory is gone after the next scan
+    before = hostCheckHealth(driver, sensors[2].rom);
+    removeSlave(root, sensors[2].rom);
+    w1.scan();
+    hostCheckMissing(driver, sensors[2].rom, before, true);
+    HOST_CHECK(!driver.verifyPresence(sensors[2].rom));
+
+    HOST_CHECK(fabs(driver.readTemperature(sensors[1].rom) - sensors[1].celsius) < 0.01f);
+  }
+
+  removeSlave(root, sensors[0].rom);
+  removeSlave(root, sensors[1].rom);
+  snprintf(master, sizeof(master), "%s/w1_bus_master1/therm_bulk_read", root);
+  unlink(master);
+  snprintf(master, sizeof(master), "%s/w1_bus_master1", root);
+  rmdir(master);
+  rmdir(root);
+  return hostCheckResult("LinuxW1");
+}
+
+#else
+int main() {
+  printf("LinuxW1: skipped (not a Linux host)\n");
+  return 0;
+}
+#endif
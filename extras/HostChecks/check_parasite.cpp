@@ -0,0 +1,76 @@
+/***************************************************************************************************
+//  check_parasite.cpp - host check of the broadcast Read Power Supply
+//  Written for the 7semi sensor platform
+//
+//  begin() asks the whole bus once (Skip ROM Read Power Supply). On an externally powered bus
+//  that is the only power query; once a parasite sensor joins, each device is asked by Match ROM
+//  and the per-device power flags follow.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_parasite.cpp ../../src/7semi_*.cpp -o check_parasite
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+// PowerQueryBus: DS18B20_SimBus counting Read Power Supply commands (0xB4 bytes written)
+class PowerQueryBus : public DS18B20_SimBus {
+public:
+  PowerQueryBus()
+    : queries(0) {}
+
+  void write(uint8_t v, uint8_t power = 0) override {
+    if (v == 0xB4) queries++;
+    DS18B20_SimBus::write(v, power);
+  }
+
+  uint32_t queries;
+};
+
+// noB4(): a ROM containing 0xB4 would be counted as a query
+static bool noB4(const uint8_t rom[8]) {
+  for (uint8_t i = 0; i < 8; i++) {
+    if (rom[i] == 0xB4) return false;
+  }
+  return true;
+}
+
+int main() {
+  PowerQueryBus sim;
+  for (uint8_t i = 0; i < 4; i++) {
+    sim.addDevice(0x9A2000 + i * 0x0321, false);
+    HOST_CHECK(noB4(sim.device(i).rom));
+  }
+
+  // externally powered bus: one broadcast query, no per-device ones
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    HOST_CHECK(driver.begin());
+    HOST_CHECK(!driver.hasParasiteDevices());
+    HOST_CHECK(sim.queries == 1);
+    uint8_t rom[8];
+    for (uint8_t i = 0; driver.getAddress(i, rom); i++) HOST_CHECK(!driver.isParasitePower(rom));
+    HOST_CHECK(sim.queries == 1);
+  }
+
+  // a parasite sensor joins: the broadcast reports it, then every device is asked once
+  int8_t parasite = sim.addDevice(0x9A2FFF, true);
+  HOST_CHECK(noB4(sim.device((uint8_t)parasite).rom));
+  sim.queries = 0;
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    HOST_CHECK(driver.begin());
+    HOST_CHECK(driver.hasParasiteDevices());
+    HOST_CHECK(sim.queries == 1 + 5);
+    for (uint8_t i = 0; i < 5; i++) {
+      HOST_CHECK(driver.isParasitePower(sim.device(i).rom) == (i == (uint8_t)parasite));
+    }
+    HOST_CHECK(sim.queries == 1 + 5);  // served from the cached flags
+    DS18B20_DeviceInfo info;
+    HOST_CHECK(driver.getDeviceInfo((uint8_t)driver.indexOf(sim.device((uint8_t)parasite).rom), info) && info.parasite);
+  }
+  return hostCheckResult("Parasite");
+}
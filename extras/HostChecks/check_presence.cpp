@@ -0,0 +1,63 @@
+/***************************************************************************************************
+//  check_presence.cpp - host check of verifyPresence(), single and batch
+//  Written for the 7semi sensor platform
+//
+//  A shuffled list of present and absent ROMs: the batch flags match the single directed searches
+//  whatever the input order, and absent ROMs behind the same empty branch of the search tree are
+//  decided without bus traffic (one reset per directed search).
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_presence.cpp ../../src/7semi_*.cpp -o check_presence
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+#define ROMS 7
+
+int main() {
+  DS18B20_SimBus sim;
+  for (uint8_t i = 0; i < 3; i++) sim.addDevice(0x9E5000 + i * 0x0A0B, false);
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  HOST_CHECK(driver.begin());
+
+  // three present, one DS18B20 ROM that differs from device 1 in its serial only, and three
+  // DS18S20 (0x10) ROMs: their family code already leaves the 0x28 branch at bit 3
+  uint8_t roms[ROMS][8];
+  static const uint8_t order[ROMS] = { 4, 0, 6, 2, 5, 1, 3 };
+  bool expected[ROMS];
+  for (uint8_t n = 0; n < ROMS; n++) {
+    uint8_t *rom = roms[order[n]];
+    if (n < 3) {
+      memcpy(rom, sim.device(n).rom, 8);
+    } else if (n == 3) {
+      memcpy(rom, sim.device(1).rom, 8);
+      rom[6] ^= 0x80;
+    } else {
+      static const uint8_t s20[8] = { 0x10, 0x31, 0x42, 0x53, 0x00, 0x00, 0x00, 0x00 };
+      memcpy(rom, s20, 8);
+      rom[4] = n;
+    }
+    expected[order[n]] = (n < 3);
+  }
+
+  for (uint8_t i = 0; i < ROMS; i++) HOST_CHECK(driver.verifyPresence(roms[i]) == expected[i]);
+
+  // batch: same answers, the three 0x10 ROMs share one search
+  bool present[ROMS];
+  memset(present, 0, sizeof(present));
+  uint32_t resets = sim.resets;
+  HOST_CHECK(driver.verifyPresence(roms, ROMS, present) == 3);
+  for (uint8_t i = 0; i < ROMS; i++) HOST_CHECK(present[i] == expected[i]);
+  HOST_CHECK(sim.resets - resets == 5);
+
+  // a device dropping off is reported by the next batch
+  sim.setConnected(2, false);
+  expected[order[2]] = false;
+  HOST_CHECK(driver.verifyPresence(roms, ROMS, present) == 2);
+  for (uint8_t i = 0; i < ROMS; i++) HOST_CHECK(present[i] == expected[i]);
+  return hostCheckResult("Presence");
+}
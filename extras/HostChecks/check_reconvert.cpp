@@ -0,0 +1,112 @@
+/***************************************************************************************************
+//  check_reconvert.cpp - host check of the power-on (85 °C) re-conversion
+//  Written for the 7semi sensor platform
+//
+//  A sensor browning out during its conversion answers with the 85 °C power-on scratchpad. The
+//  driver must convert it exactly once more, by itself, and accept a second 85 °C as genuine;
+//  a disconnected sensor (all 0xFF) is reported at once, without a re-conversion. Checked for
+//  readTemperature() and for poll() sweeps.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_reconvert.cpp ../../src/7semi_*.cpp -o check_reconvert
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+// BrownOutBus: DS18B20_SimBus whose 'victim' loses power right after the next 'pending' Convert T
+class BrownOutBus : public DS18B20_SimBus {
+public:
+  BrownOutBus()
+    : pending(0), victim(0), conversions(0) {}
+
+  bool execute(const DS18B20_Script &script, uint8_t *rx) override {
+    bool ok = DS18B20_SimBus::execute(script, rx);
+    if (ok && script.length() && script.data()[script.length() - 1] == 0x44) {  // ... Convert T
+      conversions++;
+      if (pending) {
+        pending--;
+        powerOnReset(victim);
+      }
+    }
+    return ok;
+  }
+
+  uint8_t pending;
+  uint8_t victim;
+  uint32_t conversions;
+};
+
+struct ReadingLog {
+  uint16_t readings;
+  uint16_t errors;
+  int16_t raw[3];  // by table index
+};
+
+static void onEvent(const DS18B20_Event &event, void *ctx) {
+  ReadingLog &log = *(ReadingLog *)ctx;
+  if (event.type == DS18B20_EVENT_ERROR) log.errors++;
+  if (event.type != DS18B20_EVENT_READING || event.index >= 3) return;
+  log.readings++;
+  log.raw[event.index] = event.raw;
+}
+
+int main() {
+  BrownOutBus sim;
+  HostCheckSensor sensors[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    sim.addDevice(0x385000 + i * 0x0505, false);
+    sensors[i].celsius = 19.0f + i * 2.5f;
+    sim.setTemperature(i, sensors[i].celsius);
+    memcpy(sensors[i].rom, sim.device(i).rom, 8);
+  }
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  HOST_CHECK(driver.begin());
+  for (uint8_t i = 0; i < 3; i++) HOST_CHECK(driver.setResolution(sensors[i].rom, 9));
+
+  // brown-out during the conversion: one more conversion, the real value
+  DS18B20_Health before = hostCheckHealth(driver, sensors[0].rom);
+  sim.victim = 0;
+  sim.pending = 1;
+  sim.conversions = 0;
+  HOST_CHECK(fabs(driver.readTemperature(sensors[0].rom) - sensors[0].celsius) < 0.01f);
+  HOST_CHECK(sim.conversions == 2);
+  HOST_CHECK(hostCheckHealth(driver, sensors[0].rom).retries == before.retries + 1);
+
+  // genuine 85 °C: converted twice, then accepted
+  sim.setTemperature(1, 85.0f);
+  sim.conversions = 0;
+  HOST_CHECK(driver.readTemperature(sensors[1].rom) == 85.0f);
+  HOST_CHECK(sim.conversions == 2);
+  sim.setTemperature(1, sensors[1].celsius);
+
+  // disconnected: all 0xFF is not a power-on value, no re-conversion
+  sim.setConnected(2, false);
+  sim.conversions = 0;
+  HOST_CHECK(isnan(driver.readTemperature(sensors[2].rom)));
+  HOST_CHECK(sim.conversions == 1);
+  sim.setConnected(2, true);
+
+  // poll(): the browned-out sensor is re-converted by itself after the broadcast sweep
+  ReadingLog log;
+  memset(&log, 0, sizeof(log));
+  driver.onEvent(DS18B20_EVENT_ALL, onEvent, &log);
+  sim.victim = 1;
+  sim.pending = 1;
+  sim.conversions = 0;
+  uint32_t start = millis();
+  while (log.readings < 3 && millis() - start < 2000) {
+    driver.poll();
+    delay(1);
+  }
+  HOST_CHECK(log.readings == 3 && log.errors == 0);
+  HOST_CHECK(sim.conversions == 2);
+  for (uint8_t i = 0; i < 3; i++) {
+    int16_t index = driver.indexOf(sensors[i].rom);  // events carry table indices
+    HOST_CHECK(index >= 0 && log.raw[index] == (int16_t)(sensors[i].celsius * 16.0f));
+  }
+  return hostCheckResult("Reconvert");
+}
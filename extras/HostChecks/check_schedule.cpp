@@ -0,0 +1,90 @@
+/***************************************************************************************************
+//  check_schedule.cpp - host check of poll()'s per-device schedules, swept and pipelined
+//  Written for the 7semi sensor platform
+//
+//  Four externally powered sensors on a DS18B20_SimBus with different setSchedule() periods
+//  (one switched off) are polled for a fixed time, first sweeping, then with setPipelined():
+//  in both modes every device must be read about once per period and never faster, so
+//  pipelining does not add reads nobody asked for. Runs in real time (~3 s).
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_schedule.cpp ../../src/7semi_*.cpp -o check_schedule
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+#define RUN_MS 1500UL
+#define SWEEP_MS 300UL
+
+struct ReadingLog {
+  uint16_t count[4];
+  uint32_t last[4];
+  uint32_t minGap[4];
+};
+
+static void onReading(const DS18B20_Event &event, void *ctx) {
+  ReadingLog &log = *(ReadingLog *)ctx;
+  uint8_t i = event.index;
+  if (i >= 4) return;
+  if (log.count[i] && event.timestamp - log.last[i] < log.minGap[i]) log.minGap[i] = event.timestamp - log.last[i];
+  log.last[i] = event.timestamp;
+  log.count[i]++;
+}
+
+// run(): poll for RUN_MS and check each device's reading count and spacing against its period
+template <class Driver>
+static void run(Driver &driver, const uint32_t *period, bool pipelined) {
+  ReadingLog log;
+  memset(&log, 0, sizeof(log));
+  for (uint8_t i = 0; i < 4; i++) log.minGap[i] = 0xFFFFFFFFUL;
+  driver.onEvent(DS18B20_EVENT_READING, onReading, &log);
+  for (uint8_t i = 0; i < 4; i++) driver.setSchedule(i, period[i]);
+  driver.setPipelined(pipelined);
+
+  uint32_t start = millis();
+  while (millis() - start < RUN_MS) {
+    driver.poll();
+    delay(1);
+  }
+  driver.removeEventHandler(onReading);
+
+  // a device may join a conversion up to one conversion time (94 ms at 9 bits) early
+  for (uint8_t i = 0; i < 4; i++) {
+    if (period[i] == DS18B20_SCHEDULE_OFF) {
+      HOST_CHECK(log.count[i] == 0);
+      continue;
+    }
+    uint32_t p = period[i] ? period[i] : SWEEP_MS;
+    uint32_t expected = (RUN_MS + p - 1) / p;
+    uint32_t n = log.count[i];
+    if (n + 1 < expected || n > expected + 1) {
+      printf("%s device %u: %lu readings for a %lu ms period\n", pipelined ? "pipelined" : "swept", i, (unsigned long)n, (unsigned long)p);
+    }
+    HOST_CHECK(n + 1 >= expected && n <= expected + 1);
+    HOST_CHECK(n < 2 || log.minGap[i] + 100 >= p);
+  }
+}
+
+int main() {
+  DS18B20_SimBus sim;
+  for (uint8_t i = 0; i < 4; i++) {
+    sim.addDevice(0x5C0000 + i * 0x0101, false);
+    sim.setTemperature(i, 20.0f + i);
+  }
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  HOST_CHECK(driver.begin());
+  HOST_CHECK(!driver.hasParasiteDevices());
+  uint8_t rom[8];
+  for (uint8_t i = 0; driver.getAddress(i, rom); i++) HOST_CHECK(driver.setResolution(rom, 9));
+  driver.setSweepInterval(SWEEP_MS);
+
+  // sweep interval, 1 s, off, 150 ms
+  static const uint32_t period[4] = { 0, 1000, DS18B20_SCHEDULE_OFF, 150 };
+  run(driver, period, false);
+  run(driver, period, true);
+  return hostCheckResult("Schedule");
+}
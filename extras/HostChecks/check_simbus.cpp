@@ -0,0 +1,54 @@
+/***************************************************************************************************
+//  check_simbus.cpp - host check of DS18B20_Driver on the bit-level DS18B20_SimBus
+//  Written for the 7semi sensor platform
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_simbus.cpp ../../src/7semi_*.cpp -o check_simbus
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+int main() {
+  DS18B20_SimBus sim;
+  HostCheckSensor sensors[4];
+  for (uint8_t i = 0; i < 4; i++) {
+    sim.addDevice(0x3A0000 + i * 0x1357, i == 3);  // one parasite sensor
+    sensors[i].celsius = -10.5f + i * 12.25f;
+    sim.setTemperature(i, sensors[i].celsius);
+    memcpy(sensors[i].rom, sim.device(i).rom, 8);
+  }
+
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  HOST_CHECK(driver.begin());
+  HOST_CHECK(driver.hasParasiteDevices());
+  hostCheckReadings(driver, sensors, 4);
+
+  // flip one bit of the CRC byte the sensor sends back
+  DS18B20_Health before = hostCheckHealth(driver, sensors[1].rom);
+  sim.device(1).scratchpad[8] ^= 0x01;
+  hostCheckCrcFailure(driver, sensors[1].rom, before);
+
+  // the others still answer the reset: the missing sensor reads as a floating bus
+  before = hostCheckHealth(driver, sensors[2].rom);
+  sim.setConnected(2, false);
+  hostCheckMissing(driver, sensors[2].rom, before, false);
+
+  // nobody left to answer: no presence
+  DS18B20_SimBus lone;
+  lone.addDevice(0x777777);
+  uint8_t rom[8];
+  memcpy(rom, lone.device(0).rom, 8);
+  DS18B20_Driver<DS18B20_Transport> single(lone);
+  HOST_CHECK(single.begin());
+  before = hostCheckHealth(single, rom);
+  lone.setConnected(0, false);
+  hostCheckMissing(single, rom, before, true);
+
+  // the other sensors are unaffected
+  HOST_CHECK(fabs(driver.readTemperature(sensors[0].rom) - sensors[0].celsius) < 0.01f);
+  return hostCheckResult("SimBus");
+}
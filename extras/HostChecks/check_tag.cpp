@@ -0,0 +1,85 @@
+/***************************************************************************************************
+//  check_tag.cpp - host check of tag mode (16-bit location tag in TH/TL)
+//  Written for the 7semi sensor platform
+//
+//  Tags written with setTag() survive a power-on reset (EEPROM), are read back by the next
+//  discovery without extra bus traffic, map back to table indices with indexOfTag(), and never
+//  raise ALARM events although they would be out-of-range thresholds.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_tag.cpp ../../src/7semi_*.cpp -o check_tag
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+
+struct EventCount {
+  uint16_t readings;
+  uint16_t alarms;
+};
+
+static void onEvent(const DS18B20_Event &event, void *ctx) {
+  EventCount &count = *(EventCount *)ctx;
+  if (event.type == DS18B20_EVENT_READING) count.readings++;
+  if (event.type == DS18B20_EVENT_ALARM) count.alarms++;
+}
+
+int main() {
+  DS18B20_SimBus sim;
+  for (uint8_t i = 0; i < 4; i++) {
+    sim.addDevice(0x7A6000 + i * 0x1111, false);
+    sim.setTemperature(i, 25.0f);
+  }
+  // TH = 10 °C, TL = 20 °C as thresholds: every reading would be an alarm
+  static const uint16_t tags[4] = { 0x0A14, 0x0B02, 0x0A01, 0x0C30 };
+
+  {
+    DS18B20_Driver<DS18B20_Transport> driver(sim);
+    driver.setTagMode(true);
+    HOST_CHECK(driver.begin());
+    for (uint8_t i = 0; i < 4; i++) HOST_CHECK(driver.setTag(i, tags[i]));
+    for (uint8_t i = 0; i < 4; i++) HOST_CHECK(driver.indexOfTag(tags[i]) == i);
+  }
+
+  // brown-out of every sensor: tags come back from EEPROM with the next discovery
+  for (uint8_t i = 0; i < 4; i++) sim.powerOnReset(i);
+  DS18B20_Driver<DS18B20_Transport> driver(sim);
+  driver.setTagMode(true);
+  HOST_CHECK(driver.begin());
+  uint32_t resets = sim.resets;
+  for (uint8_t i = 0; i < 4; i++) {
+    uint16_t tag = 0;
+    HOST_CHECK(driver.getTag(i, tag) && tag == tags[i]);
+    HOST_CHECK(driver.indexOfTag(tags[i]) == i);
+  }
+  HOST_CHECK(driver.indexOfTag(0x0A15) == -1);
+  HOST_CHECK(sim.resets == resets);  // lookups are served from the table
+
+  // poll() readings: no ALARM events in tag mode
+  uint8_t rom[8];
+  for (uint8_t i = 0; driver.getAddress(i, rom); i++) HOST_CHECK(driver.setResolution(rom, 9));
+  EventCount count = { 0, 0 };
+  driver.onEvent(DS18B20_EVENT_ALL, onEvent, &count);
+  uint32_t start = millis();
+  while (count.readings < 4 && millis() - start < 2000) {
+    driver.poll();
+    delay(1);
+  }
+  HOST_CHECK(count.readings >= 4);
+  HOST_CHECK(count.alarms == 0);
+
+  // without tag mode the same bytes are thresholds again
+  driver.setTagMode(false);
+  HOST_CHECK(driver.indexOfTag(tags[0]) == -1);
+  count.readings = 0;
+  start = millis();
+  while (count.readings < 4 && millis() - start < 3000) {
+    driver.poll();
+    delay(1);
+  }
+  HOST_CHECK(count.alarms > 0);
+  return hostCheckResult("Tag");
+}
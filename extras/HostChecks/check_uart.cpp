@@ -0,0 +1,65 @@
+/***************************************************************************************************
+//  check_uart.cpp - host check of DS18B20_Driver on the UART transport
+//  Written for the 7semi sensor platform
+//
+//  DS18B20_UARTBusT drives a DS18B20_UARTSim port, which turns the UART bytes into reset pulses
+//  and time slots on a DS18B20_SimBus and echoes them back like a UART tied to the bus.
+//  Also checks that a scratchpad read stays one slot transfer, with and without tracing.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src check_uart.cpp ../../src/7semi_*.cpp -o check_uart
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "host_check.h"
+#include "7semi_DS18B20_SimBus.h"
+#include "7semi_DS18B20_UARTSim.h"
+
+int main() {
+  DS18B20_SimBus sim;
+  HostCheckSensor sensors[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    sim.addDevice(0x0A5000 + i * 0x2468, false);
+    sensors[i].celsius = 55.0f - i * 30.0625f;
+    sim.setTemperature(i, sensors[i].celsius);
+    memcpy(sensors[i].rom, sim.device(i).rom, 8);
+  }
+
+  DS18B20_UARTSim port(sim);
+  DS18B20_UARTBusT<DS18B20_UARTSim> uart(port);
+  uart.begin();
+  DS18B20_Driver<DS18B20_Transport> driver(uart);
+  HOST_CHECK(driver.begin());
+  HOST_CHECK(!driver.hasParasiteDevices());
+  hostCheckReadings(driver, sensors, 3);
+
+  // a Read Scratchpad is the reset plus one transfer of Match ROM, 0xBE and the 9 read bytes
+  uint8_t sp[9];
+  uint32_t calls = port.writeCalls;
+  uint32_t transfers = uart.transfers();
+  HOST_CHECK(driver.readScratchpad(sensors[0].rom, sp));
+  HOST_CHECK(port.writeCalls - calls == 2);
+  HOST_CHECK(uart.transfers() - transfers == 1);
+
+  // tracing hands the script to the UART unchanged
+  DS18B20_Trace trace;
+  DS18B20_TraceBusT<DS18B20_Transport> traced(uart, trace);
+  DS18B20_Driver<DS18B20_Transport> tracedDriver(traced);
+  HOST_CHECK(tracedDriver.begin());
+  calls = port.writeCalls;
+  HOST_CHECK(tracedDriver.readScratchpad(sensors[0].rom, sp));
+  HOST_CHECK(port.writeCalls - calls == 2);
+
+  DS18B20_Health before = hostCheckHealth(driver, sensors[1].rom);
+  sim.device(1).scratchpad[0] ^= 0x08;  // temperature LSB changed without a new CRC
+  hostCheckCrcFailure(driver, sensors[1].rom, before);
+
+  before = hostCheckHealth(driver, sensors[2].rom);
+  sim.setConnected(2, false);
+  hostCheckMissing(driver, sensors[2].rom, before, false);
+
+  HOST_CHECK(fabs(driver.readTemperature(sensors[0].rom) - sensors[0].celsius) < 0.01f);
+  return hostCheckResult("UART");
+}
@@ -0,0 +1,89 @@
+/***************************************************************************************************
+//  host_check.h - shared checks for the host programs in extras/HostChecks
+//  Written for the 7semi sensor platform
+//
+//  Each check_<backend>.cpp builds DS18B20_Driver on one transport backed by a stand-in (SimBus,
+//  DS2482Sim, UARTSim, a fake w1 sysfs tree) and runs the same driver paths through it: search,
+//  readTemperature() of every sensor, a scratchpad CRC failure and a missing sensor, both of
+//  which must be counted in the device's health counters. The other check_*.cpp programs each
+//  run one driver feature against a DS18B20_SimBus. Exit status 0 = all checks passed.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_HOST_CHECK_H_
+#define _7SEMI_DS18B20_HOST_CHECK_H_
+
+#include <stdio.h>
+#include <math.h>
+#include "7semi_DS18B20.h"
+
+static unsigned hostCheckFailures = 0;
+
+#define HOST_CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      hostCheckFailures++; \
+    } \
+  } while (0)
+
+// HostCheckSensor: ROM and expected temperature of one sensor behind the backend.
+struct HostCheckSensor {
+  uint8_t rom[8];
+  float celsius;
+};
+
+// hostCheckReadings(): the search found exactly these sensors and each reads its temperature.
+template <class Driver>
+void hostCheckReadings(Driver &driver, const HostCheckSensor *sensors, uint8_t count) {
+  HOST_CHECK(driver.getDeviceCount() == count);
+  for (uint8_t i = 0; i < count; i++) {
+    HOST_CHECK(driver.indexOf(sensors[i].rom) >= 0);
+    float t = driver.readTemperature(sensors[i].rom);
+    HOST_CHECK(fabs(t - sensors[i].celsius) < 0.01f);
+  }
+}
+
+// hostCheckHealth(): snapshot of one sensor's health counters (all zero if it is not listed).
+template <class Driver>
+DS18B20_Health hostCheckHealth(Driver &driver, const uint8_t rom[8]) {
+  DS18B20_Health h;
+  memset(&h, 0, sizeof(h));
+  int16_t index = driver.indexOf(rom);
+  if (index >= 0) driver.getHealth((uint8_t)index, h);
+  return h;
+}
+
+// hostCheckCrcFailure(): a corrupted scratchpad is rejected and counted as one CRC error.
+template <class Driver>
+void hostCheckCrcFailure(Driver &driver, const uint8_t rom[8], const DS18B20_Health &before) {
+  uint8_t sp[9];
+  HOST_CHECK(!driver.readScratchpad(rom, sp));
+  DS18B20_Health after = hostCheckHealth(driver, rom);
+  HOST_CHECK(after.crcErrors == before.crcErrors + 1);
+  HOST_CHECK(after.noPresence == before.noPresence);
+}
+
+// hostCheckMissing(): a sensor that left the bus fails its read and is counted exactly once:
+// as no presence where the backend can tell (nobody answered, or the w1 slave is gone), or as
+// an all-0xFF (disconnected) read, a CRC error, when other sensors still answer the reset.
+template <class Driver>
+void hostCheckMissing(Driver &driver, const uint8_t rom[8], const DS18B20_Health &before, bool noPresence) {
+  uint8_t sp[9];
+  memset(sp, 0xFF, sizeof(sp));
+  HOST_CHECK(!driver.readScratchpad(rom, sp));
+  HOST_CHECK(DS18B20_Common::classifyScratchpad(sp) == DS18B20_STATUS_DISCONNECTED);
+  DS18B20_Health after = hostCheckHealth(driver, rom);
+  HOST_CHECK(after.noPresence == before.noPresence + (noPresence ? 1 : 0));
+  HOST_CHECK(after.crcErrors == before.crcErrors + (noPresence ? 0 : 1));
+}
+
+// hostCheckResult(): summary line and exit status
+static int hostCheckResult(const char *backend) {
+  printf("%s: %s (%u failure(s))\n", backend, hostCheckFailures ? "FAILED" : "ok", hostCheckFailures);
+  return hostCheckFailures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,110 @@
+/***************************************************************************************************
+//  ds18b20_pullup_latency.cpp - strong pull-up arm latency benchmark on the host simulator
+//  Written for the 7semi sensor platform
+//
+//  The datasheet requires the strong pull-up within 10 us of the last Convert T bit. This tool
+//  runs startConversion() (Match ROM) and startConversionAll() (Skip ROM) against DS18B20_SimBus
+//  with parasite sensors and measures the time from the end of the last command write slot to
+//  the pull-up pin going HIGH (observed through DS18B20_hostPinWrite). The host micros() shim
+//  only resolves 1 us, so both ends are stamped with CLOCK_MONOTONIC in ns.
+//
+//  On a host this is the driver's own work between the command and the pin (power mode and
+//  resolution lookups, deadline bookkeeping); the register write itself is not modelled, so
+//  treat the result as a lower bound and a regression check for code added to that window.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src ds18b20_pullup_latency.cpp ../../src/7semi_*.cpp -o ds18b20_pullup_latency
+//  Usage:
+//    ds18b20_pullup_latency [iterations]
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "7semi_DS18B20.h"
+#include "7semi_DS18B20_SimBus.h"
+
+#define PULLUP_PIN 4
+#define BUDGET_NS 10000UL
+
+static uint64_t nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t lastSlotNs;  // end of the most recent write slot
+static uint64_t pinHighNs;   // first HIGH write since the last reset of this stamp
+
+// StampBus: simulator that stamps the end of every write slot.
+class StampBus : public DS18B20_SimBus {
+public:
+  void writeBit(uint8_t v) override {
+    DS18B20_SimBus::writeBit(v);
+    lastSlotNs = nowNs();
+  }
+};
+
+static void onPinWrite(uint8_t pin, uint8_t value) {
+  if (pin == PULLUP_PIN && value == HIGH && pinHighNs == 0) pinHighNs = nowNs();
+}
+
+static int compareU32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+// measure(): one fresh driver per sample, so no conversion is pending when it starts
+static bool measure(StampBus &bus, bool broadcast, uint32_t *samples, uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    DS18B20_Driver<DS18B20_Transport> driver(bus, PULLUP_PIN);
+    if (!driver.begin()) return false;
+    uint8_t addr[8];
+    driver.getAddress(0, addr);
+    pinHighNs = 0;
+    bool started = broadcast ? driver.startConversionAll() : driver.startConversion(addr);
+    if (!started || pinHighNs == 0) return false;
+    samples[i] = (uint32_t)(pinHighNs - lastSlotNs);
+  }
+  return true;
+}
+
+static void report(const char *name, uint32_t *samples, uint32_t n) {
+  qsort(samples, n, sizeof(samples[0]), compareU32);
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < n; i++) sum += samples[i];
+  uint32_t p99 = samples[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1];
+  printf("%-22s min %6lu  median %6lu  mean %6lu  p99 %6lu  max %6lu ns  %s\n", name, (unsigned long)samples[0], (unsigned long)samples[n / 2], (unsigned long)(sum / n), (unsigned long)p99, (unsigned long)samples[n - 1], samples[n - 1] <= BUDGET_NS ? "ok" : "OVER 10 us");
+}
+
+int main(int argc, char **argv) {
+  uint32_t n = (argc > 1) ? (uint32_t)strtoul(argv[1], nullptr, 10) : 2000;
+  if (n == 0) n = 1;
+  uint32_t *samples = (uint32_t *)malloc(n * sizeof(uint32_t));
+  if (!samples) return 2;
+
+  StampBus bus;
+  for (uint8_t i = 0; i < 4; i++) bus.addDevice(0x1000 + i * 0x111, true);
+  DS18B20_hostPinWrite = onPinWrite;
+
+  printf("strong pull-up arm latency, %lu samples, 4 parasite sensors\n", (unsigned long)n);
+  int rc = 0;
+  if (measure(bus, false, samples, n)) {
+    report("startConversion()", samples, n);
+  } else {
+    printf("startConversion(): pull-up was not armed\n");
+    rc = 1;
+  }
+  if (measure(bus, true, samples, n)) {
+    report("startConversionAll()", samples, n);
+  } else {
+    printf("startConversionAll(): pull-up was not armed\n");
+    rc = 1;
+  }
+  free(samples);
+  return rc;
+}
@@ -0,0 +1,62 @@
+/*******************************************************
+ * @file SizeReport.ino
+ *
+ * @brief Fixed workload compiled once per feature policy by size_report.sh.
+ *
+ * DS18B20_SIZE_CONFIG (set by the script) selects the driver configuration:
+ * - 0: DS18B20_7semi, all features
+ * - 1: DS18B20_NoParasite<>
+ * - 2: DS18B20_NoAlarms<DS18B20_NoEeprom<> >
+ * - 3: DS18B20_FixedResolution<12>
+ * - 4: DS18B20_SingleDevice<>
+ * - 5: the ATtiny node: one externally powered sensor at 12 bits, no alarms,
+ *      no EEPROM, no write verification
+ *
+ * The sketch only uses calls every configuration supports, so the size difference
+ * is what the policies remove.
+ *
+ * @section author Author
+ * Written by 7Semi
+ *
+ * @section license License
+ * @license MIT
+ * Copyright (c) 2025 7Semi
+ *******************************************************/
+
+#include <7semi_DS18B20.h>
+
+#ifndef DS18B20_SIZE_CONFIG
+#define DS18B20_SIZE_CONFIG 0
+#endif
+
+#if DS18B20_SIZE_CONFIG == 0
+DS18B20_7semi sensor(2, 3);
+#elif DS18B20_SIZE_CONFIG == 1
+DS18B20_7semiT<DS18B20_NoParasite<> > sensor(2);
+#elif DS18B20_SIZE_CONFIG == 2
+DS18B20_7semiT<DS18B20_NoAlarms<DS18B20_NoEeprom<> > > sensor(2, 3);
+#elif DS18B20_SIZE_CONFIG == 3
+DS18B20_7semiT<DS18B20_FixedResolution<12> > sensor(2, 3);
+#elif DS18B20_SIZE_CONFIG == 4
+DS18B20_7semiT<DS18B20_SingleDevice<> > sensor(2, 3);
+#else
+DS18B20_7semiT<DS18B20_SingleDevice<DS18B20_NoParasite<DS18B20_NoAlarms<DS18B20_NoEeprom<DS18B20_NoVerify<DS18B20_FixedResolution<12> > > > > > > sensor(2);
+#endif
+
+uint8_t addr[8];
+
+void setup() {
+  sensor.begin();
+  sensor.getAddress(0, addr);
+  sensor.setResolution(addr, 12, true);
+  int8_t th, tl;
+  if (sensor.getAlarms(addr, th, tl)) sensor.setAlarms(addr, th + 1, tl, true);
+}
+
+void loop() {
+  float t = sensor.readTemperature(addr);
+  // keep the result alive without pulling in Serial / float printing
+  volatile uint8_t sink = (uint8_t)t;
+  (void)sink;
+  delay(1000);
+}
@@ -0,0 +1,37 @@
+#!/bin/sh
+# size_report.sh - flash / RAM of extras/SizeReport/SizeReport for every feature policy
+#
+# Needs arduino-cli with the board core and the OneWire library installed; the library is
+# taken from this checkout. Usage (FQBN defaults to the Uno):
+#   extras/SizeReport/size_report.sh [fqbn]
+#   extras/SizeReport/size_report.sh ATTinyCore:avr:attinyx5:chip=85,clock=8internal
+#
+# Author: 7semi
+# License: MIT
+
+FQBN=${1:-arduino:avr:uno}
+DIR=$(cd "$(dirname "$0")" && pwd)
+LIB=$(cd "$DIR/../.." && pwd)
+SKETCH="$DIR/SizeReport"
+
+printf '%-3s %-34s %8s %8s\n' "#" "configuration" "flash" "ram"
+for n in 0 1 2 3 4 5; do
+  case $n in
+    0) name="full (DS18B20_7semi)" ;;
+    1) name="NoParasite" ;;
+    2) name="NoAlarms + NoEeprom" ;;
+    3) name="FixedResolution<12>" ;;
+    4) name="SingleDevice" ;;
+    5) name="tiny node (all of the above)" ;;
+  esac
+  out=$(arduino-cli compile --fqbn "$FQBN" --library "$LIB" \
+    --build-property "compiler.cpp.extra_flags=-DDS18B20_SIZE_CONFIG=$n" "$SKETCH" 2>&1)
+  if [ $? -ne 0 ]; then
+    printf '%-3s %-34s %s\n' "$n" "$name" "build failed"
+    echo "$out" | grep -m 5 "error"
+    continue
+  fi
+  flash=$(echo "$out" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')
+  ram=$(echo "$out" | sed -n 's/^Global variables use \([0-9]*\) bytes.*/\1/p')
+  printf '%-3s %-34s %8s %8s\n' "$n" "$name" "$flash" "$ram"
+done
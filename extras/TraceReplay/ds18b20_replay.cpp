@@ -0,0 +1,181 @@
+/***************************************************************************************************
+//  ds18b20_replay.cpp - decode and replay a DS18B20_Trace dump on Linux
+//  Written for the 7semi sensor platform
+//
+//  Reads a trace dump (one "<micros> <code> <hex>" line per event, see 7semi_DS18B20_Trace.h),
+//  prints the decoded 1-Wire transactions with their recorded timing (pull-up on-time, gaps,
+//  scratchpad CRC / sentinel classification) and then replays the trace through the library:
+//  DS18B20_ReplayBus serves the recorded presence, search and read data to DS18B20_Driver, which
+//  runs begin() followed by readTemperature() of every device until the trace is consumed.
+//  The first point where the driver's bus calls diverge from the recording is reported.
+//
+//  Build (from this directory):
+//    g++ -std=gnu++11 -O2 -I../../src ds18b20_replay.cpp ../../src/7semi_*.cpp -o ds18b20_replay
+//  Usage:
+//    ds18b20_replay trace.txt [--decode-only]
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "7semi_DS18B20.h"
+
+static const char *functionName(uint8_t cmd) {
+  switch (cmd) {
+    case 0x44: return "Convert T";
+    case 0xBE: return "Read Scratchpad";
+    case 0x4E: return "Write Scratchpad";
+    case 0x48: return "Copy Scratchpad";
+    case 0xB8: return "Recall E2";
+    case 0xB4: return "Read Power Supply";
+    case 0xEC: return "Alarm Search";
+    case 0xF0: return "Search ROM";
+  }
+  return "unknown";
+}
+
+static const char *statusName(uint8_t status) {
+  switch (status) {
+    case DS18B20_STATUS_OK: return "ok";
+    case DS18B20_STATUS_CRC_ERROR: return "CRC error";
+    case DS18B20_STATUS_POWER_ON_RESET: return "power-on 85 C";
+    case DS18B20_STATUS_DISCONNECTED: return "disconnected (all FF)";
+    case DS18B20_STATUS_BUS_LOW: return "bus low (all 00)";
+    case DS18B20_STATUS_INVALID: return "invalid config/reserved";
+  }
+  return "?";
+}
+
+// load(): parse the dump into a growing array
+static DS18B20_TraceEvent *load(const char *path, uint32_t &count) {
+  FILE *f = fopen(path, "r");
+  if (!f) return nullptr;
+  uint32_t cap = 1024;
+  DS18B20_TraceEvent *events = (DS18B20_TraceEvent *)malloc(cap * sizeof(DS18B20_TraceEvent));
+  char line[64];
+  count = 0;
+  while (events && fgets(line, sizeof(line), f)) {
+    DS18B20_TraceEvent e;
+    if (!DS18B20_Trace::parse(line, e)) continue;
+    if (count == cap) {
+      cap *= 2;
+      events = (DS18B20_TraceEvent *)realloc(events, cap * sizeof(DS18B20_TraceEvent));
+      if (!events) break;
+    }
+    events[count++] = e;
+  }
+  fclose(f);
+  return events;
+}
+
+// decode(): one line per transaction, timestamps relative to the first event
+static void decode(const DS18B20_TraceEvent *ev, uint32_t count) {
+  if (count == 0) return;
+  uint32_t t0 = ev[0].us;
+  uint32_t pullupOn = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    const DS18B20_TraceEvent &e = ev[i];
+    uint32_t t = e.us - t0;
+    switch (e.type) {
+      case DS18B20_TRACE_RESET: {
+        printf("%10lu  reset%s", (unsigned long)t, e.value ? "" : " - NO PRESENCE");
+        uint32_t j = i + 1;
+        if (j < count && ev[j].type == DS18B20_TRACE_WRITE && ev[j].value == 0x55 && j + 8 < count) {
+          printf(", Match ROM %02X-", (unsigned)ev[j + 1].value);
+          for (int k = 7; k >= 2; k--) printf("%02X", (unsigned)ev[j + k].value);
+          j += 9;
+        } else if (j < count && ev[j].type == DS18B20_TRACE_WRITE && ev[j].value == 0xCC) {
+          printf(", Skip ROM");
+          j++;
+        }
+        if (j < count && (ev[j].type == DS18B20_TRACE_WRITE || ev[j].type == DS18B20_TRACE_WRITE_POWER)) {
+          uint8_t cmd = (uint8_t)ev[j].value;
+          printf(", %s", functionName(cmd));
+          if (cmd == 0xBE) {
+            uint8_t sp[9];
+            uint8_t n = 0;
+            while (n < 9 && j + 1 + n < count && ev[j + 1 + n].type == DS18B20_TRACE_READ) {
+              sp[n] = (uint8_t)ev[j + 1 + n].value;
+              n++;
+            }
+            printf(":");
+            for (uint8_t k = 0; k < n; k++) printf(" %02X", sp[k]);
+            if (n == 9) {
+              uint8_t status = DS18B20_Common::classifyScratchpad(sp);
+              printf(" -> %s", statusName(status));
+              if (status == DS18B20_STATUS_OK) printf(", %.4f C", (int16_t)((sp[1] << 8) | sp[0]) / 16.0f);
+            }
+          }
+        }
+        printf("\n");
+        break;
+      }
+      case DS18B20_TRACE_SEARCH:
+        printf("%10lu  %s:", (unsigned long)t, (e.value & 2) ? "alarm search" : "search");
+        if (!(e.value & 1)) printf(" done");
+        for (uint32_t k = 1; (e.value & 1) && k <= 8 && i + k < count; k++) printf(" %02X", (unsigned)ev[i + k].value);
+        printf("\n");
+        break;
+      case DS18B20_TRACE_PULLUP:
+        if (e.value) {
+          pullupOn = e.us;
+          printf("%10lu  strong pull-up on\n", (unsigned long)t);
+        } else {
+          printf("%10lu  strong pull-up off after %lu us\n", (unsigned long)t, (unsigned long)(e.us - pullupOn));
+        }
+        break;
+      case DS18B20_TRACE_WAIT:
+        printf("%10lu  wait armed, %u ms\n", (unsigned long)t, (unsigned)e.value);
+        break;
+      case DS18B20_TRACE_DEPOWER:
+        printf("%10lu  depower\n", (unsigned long)t);
+        break;
+    }
+  }
+}
+
+// replay(): run the driver against the recording
+static int replay(const DS18B20_TraceEvent *ev, uint32_t count) {
+  DS18B20_ReplayBus bus(ev, count);
+  DS18B20_Driver<DS18B20_Transport> driver(bus);
+  bool found = driver.begin();
+  uint8_t addr[8];
+  uint8_t devices = 0;
+  while (driver.getAddress(devices, addr)) devices++;
+  printf("replay: begin() %s, %u device(s)\n", found ? "ok" : "failed", devices);
+  for (uint32_t round = 0; !bus.exhausted() && bus.mismatches == 0 && round < 100000; round++) {
+    for (uint8_t i = 0; driver.getAddress(i, addr) && !bus.exhausted() && bus.mismatches == 0; i++) {
+      float t = driver.readTemperature(addr);
+      printf("replay: event %lu device %u: %.4f C\n", (unsigned long)bus.position(), i, t);
+    }
+    if (!driver.getAddress(0, addr)) break;
+  }
+  if (bus.mismatches) {
+    printf("replay: diverged at event %lu (%lu mismatching calls)\n", (unsigned long)bus.firstMismatch(), (unsigned long)bus.mismatches);
+    return 1;
+  }
+  printf("replay: all %lu events consumed\n", (unsigned long)count);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s trace.txt [--decode-only]\n", argv[0]);
+    return 2;
+  }
+  uint32_t count = 0;
+  DS18B20_TraceEvent *events = load(argv[1], count);
+  if (!events) {
+    perror(argv[1]);
+    return 2;
+  }
+  printf("%lu events\n", (unsigned long)count);
+  decode(events, count);
+  int rc = 0;
+  if (argc < 3 || strcmp(argv[2], "--decode-only") != 0) rc = replay(events, count);
+  free(events);
+  return rc;
+}
@@ -2,7 +2,10 @@
 //  7semi_DS18B20.h - DS18B20 Temperature Sensor Library
 //  Written for the 7semi sensor platform
 //
-//  Full-feature DS18B20 library using OneWire only.
+//  Full-feature DS18B20 library. The default DS18B20_7semi class uses OneWire; other 1-Wire
+//  masters plug in through DS18B20_Driver<Bus> (see 7semi_DS18B20_Transport.h). Host builds
+//  (ARDUINO undefined) use 7semi_DS18B20_Host.h and have no OneWire default. Features can be
+//  compiled out per driver with the policies in 7semi_DS18B20_Config.h.
 //  Supports multi-device, alarms, EEPROM, parasite power strong pull-up, CRC checks.
 // 
 //  Author: 7semi
@@ -12,31 +15,246 @@
 #ifndef _7SEMI_DS18B20_H_
 #define _7SEMI_DS18B20_H_
 
-#include <Arduino.h>
+#include "7semi_DS18B20_Transport.h"
+#include "7semi_DS18B20_Config.h"
+#include "7semi_DS18B20_FastPin.h"
+#include "7semi_DS18B20_Filter.h"
+#include "7semi_DS18B20_Latency.h"
+#include "7semi_DS18B20_Trace.h"
+#if defined(ARDUINO)
 #include <OneWire.h>
+#endif
+
+// Per-device filter stage (setFilter()); 0 removes it and its state from the device table
+#ifndef DS18B20_FILTERS
+#define DS18B20_FILTERS 1
+#endif
+
+// Per-device bus-health counters (getHealth()); 0 removes them from the device table
+#ifndef DS18B20_HEALTH
+#define DS18B20_HEALTH 1
+#endif
+
+// Per-device sampling periods and priorities for poll() (setSchedule()); 0 reads every device
+// once per sweep interval
+#ifndef DS18B20_SCHEDULER
+#define DS18B20_SCHEDULER 1
+#endif
+
+// Overlapped two-group sampling for externally powered buses (setPipelined()); 0 removes it
+#ifndef DS18B20_PIPELINE
+#define DS18B20_PIPELINE 1
+#endif
+
+// setSchedule() period: never read the device in poll()
+#define DS18B20_SCHEDULE_OFF 0xFFFFFFFFUL
+
+// Per-device metadata flags cached in the device table
+#define DS18B20_FLAG_VALID 0x01     // metadata has been read from the device
+#define DS18B20_FLAG_PARASITE 0x02  // device reported parasite power
+#define DS18B20_FLAG_SEEN 0x04      // found by the running rescan (internal)
+#define DS18B20_FLAG_NEW 0x08       // added by the running rescan (internal)
+#define DS18B20_FLAG_RECONVERT 0x10  // power-on value read, re-conversion pending (internal)
+#define DS18B20_FLAG_DUE 0x20        // member of the running poll() conversion (internal)
+
+// Reading status codes
+#define DS18B20_STATUS_OK 0
+#define DS18B20_STATUS_CRC_ERROR 1    // scratchpad CRC mismatch
+#define DS18B20_STATUS_NO_PRESENCE 2  // no presence pulse / device not answering
+#define DS18B20_STATUS_POWER_ON_RESET 3  // 85 °C power-on value, no conversion since a reset / brown-out
+#define DS18B20_STATUS_DISCONNECTED 4    // all 0xFF: device dropped off, bus floating high (-0.0625 / 0xFFFF)
+#define DS18B20_STATUS_BUS_LOW 5         // all 0x00: bus held low (passes CRC)
+#define DS18B20_STATUS_INVALID 6         // CRC ok but config / reserved byte 5 impossible
+#define DS18B20_STATUS_SPIKE 7           // dropped by the filter's spike rejector
 
-#define DS18B20_MAX_DEVICES 16
+// Event types (bit mask for onEvent())
+#define DS18B20_EVENT_READING 0x01  // new temperature reading
+#define DS18B20_EVENT_ERROR 0x02    // device could not be read
+#define DS18B20_EVENT_ALARM 0x04    // reading at or beyond the cached TH/TL
+#define DS18B20_EVENT_ADDED 0x08    // device appeared in a rescan
+#define DS18B20_EVENT_REMOVED 0x10  // device disappeared in a rescan
+#define DS18B20_EVENT_ALL 0x1F
+
+// _recordHealth() events
+#define DS18B20_HEALTH_OK 0
+#define DS18B20_HEALTH_CRC 1
+#define DS18B20_HEALTH_NO_PRESENCE 2
+#define DS18B20_HEALTH_VERIFY 3
+#define DS18B20_HEALTH_SENTINEL 4
+#define DS18B20_HEALTH_RETRY 5
+
+// poll() scheduler states
+#define DS18B20_SWEEP_IDLE 0
+#define DS18B20_SWEEP_CONVERTING 1   // broadcast conversion running
+#define DS18B20_SWEEP_RECONVERTING 2  // single-device re-conversion after a power-on value
+
+// Callback slots for onEvent()
+#ifndef DS18B20_MAX_CALLBACKS
+#define DS18B20_MAX_CALLBACKS 4
+#endif
 
-class DS18B20_7semi {
+// Persistent cache layout: magic, version, count, records, CRC8 trailer
+#define DS18B20_CACHE_MAGIC 0xD7
+#define DS18B20_CACHE_VERSION 1
+#define DS18B20_CACHE_HEADER_SIZE 3
+#define DS18B20_CACHE_RECORD_SIZE 12
+#define DS18B20_CACHE_SIZE (DS18B20_CACHE_HEADER_SIZE + DS18B20_MAX_DEVICES * DS18B20_CACHE_RECORD_SIZE + 1)
+
+// DS18B20_DeviceInfo: snapshot of the cached metadata for one device table entry.
+struct DS18B20_DeviceInfo {
+  uint8_t resolution;  // 9..12, or 0 if unknown
+  int8_t th;
+  int8_t tl;
+  bool parasite;
+  bool valid;
+};
+
+// DS18B20_Event: payload delivered to event callbacks.
+struct DS18B20_Event {
+  uint8_t type;        // one DS18B20_EVENT_* bit
+  uint8_t index;       // device table index (REMOVED: index before removal)
+  uint8_t status;      // DS18B20_STATUS_*
+  int16_t raw;         // temperature in 1/16 °C (READING / ALARM)
+  uint32_t timestamp;  // millis() of the reading
+};
+
+// DS18B20_Health: per-device error counters (saturating) and decayed error rate.
+struct DS18B20_Health {
+  uint16_t crcErrors;     // scratchpad CRC mismatches
+  uint16_t noPresence;    // no presence pulse on a Match ROM transaction
+  uint16_t verifyErrors;  // Write Scratchpad read-back mismatches
+  uint16_t sentinels;     // power-on / bus-low / invalid scratchpad patterns
+  uint16_t retries;       // re-conversions
+  uint16_t errorRate;     // share of failing transactions, 0..65535, decays by 1/16 per transaction
+};
+
+typedef void (*DS18B20_EventCallback)(const DS18B20_Event &event, void *ctx);
+
+// DS18B20_CacheStore: pluggable backing store for the device table cache.
+// read()/write() transfer 'len' bytes at byte 'offset' and return false on failure.
+class DS18B20_CacheStore {
 public:
-  // Constructor: dataPin is the 1-Wire bus pin. strongPullupPin optional for parasite power.
-  DS18B20_7semi(uint8_t dataPin, int8_t strongPullupPin = -1);
+  virtual ~DS18B20_CacheStore() {}
+  virtual bool read(uint16_t offset, uint8_t *data, uint16_t len) = 0;
+  virtual bool write(uint16_t offset, const uint8_t *data, uint16_t len) = 0;
+};
+
+// DS18B20_CallbackStore: cache store forwarding to user callbacks (e.g. flash, SD card, host file).
+class DS18B20_CallbackStore : public DS18B20_CacheStore {
+public:
+  typedef bool (*ReadFn)(void *ctx, uint16_t offset, uint8_t *data, uint16_t len);
+  typedef bool (*WriteFn)(void *ctx, uint16_t offset, const uint8_t *data, uint16_t len);
+
+  DS18B20_CallbackStore(ReadFn readFn, WriteFn writeFn, void *ctx = nullptr)
+    : _readFn(readFn), _writeFn(writeFn), _ctx(ctx) {}
+
+  bool read(uint16_t offset, uint8_t *data, uint16_t len) override {
+    return _readFn && _readFn(_ctx, offset, data, len);
+  }
+  bool write(uint16_t offset, const uint8_t *data, uint16_t len) override {
+    return _writeFn && _writeFn(_ctx, offset, data, len);
+  }
+
+private:
+  ReadFn _readFn;
+  WriteFn _writeFn;
+  void *_ctx;
+};
+
+// DS18B20_Common: bus-independent helpers shared by all DS18B20_Driver instantiations.
+class DS18B20_Common {
+public:
+  // getROM64(): convert address[8] to uint64_t (LSB first).
+  static uint64_t getROM64(const uint8_t addr[8]);
+
+  // fromROM64(): convert uint64_t (LSB first) back to address[8].
+  static void fromROM64(uint64_t rom64, uint8_t addr[8]);
+
+  // crc8(): helper to compute 1-Wire CRC8
+  static uint8_t crc8(const uint8_t *data, uint8_t len);
+
+  // classifyScratchpad(): DS18B20_STATUS_* of a 9-byte scratchpad read, detecting the
+  // disconnected / bus-low / power-on sentinel patterns besides CRC errors.
+  static uint8_t classifyScratchpad(const uint8_t sp[9]);
+
+protected:
+  static uint8_t _configToResolution(uint8_t config);
+  static uint8_t _resolutionToConfig(uint8_t resolution);
+  static int8_t _compareROM(const uint8_t a[8], const uint8_t b[8]);
+  static int8_t _compareSearchOrder(const uint8_t a[8], const uint8_t b[8]);
+  static uint8_t _crc8Update(uint8_t crc, uint8_t data);
+};
 
-  // begin(): Initialize OneWire and discover devices (returns true if at least one found).
+// DS18B20_Driver: DS18B20 device table and commands on top of any 1-Wire transport 'Bus';
+// 'Config' selects the compiled-in features (DS18B20_DefaultConfig: all of them).
+template <class Bus, class Config = DS18B20_DefaultConfig>
+class DS18B20_Driver : public DS18B20_Common {
+public:
+  // Constructor: bus must outlive the driver. strongPullupPin optional for parasite power.
+  DS18B20_Driver(Bus &bus, int8_t strongPullupPin = -1);
+
+  // getBus(): underlying transport.
+  Bus &getBus() { return _bus; }
+
+  // begin(): Initialize bus and discover devices (returns true if at least one found).
+  // With DS18B20_FixedResolution<N>, devices at another resolution are reprogrammed (and the
+  // setting copied to EEPROM unless compiled out) as they are discovered.
+  // With a cache store set, cached devices are verified by Match ROM reads and the full
+  // ROM search only runs when the cache is missing, corrupt or a device does not answer.
   bool begin();
 
-  // searchDevices(): scans bus and stores up to DS18B20_MAX_DEVICES addresses. Returns count.
+  // setCacheStore(): attach a persistent store for the device table (nullptr to detach).
+  void setCacheStore(DS18B20_CacheStore *store);
+
+  // loadCache(): load device table and metadata from the cache store. Returns true if valid.
+  bool loadCache();
+
+  // saveCache(): write device table and metadata to the cache store. Returns true on success.
+  bool saveCache();
+
+  // searchDevices(): scans bus and stores up to Config::maxDevices addresses sorted by ROM64. Returns count.
+  // SingleDevice configurations use Read ROM instead of the search.
   uint8_t searchDevices();
 
+  // getDeviceCount(): number of devices in the table.
+  uint8_t getDeviceCount() const { return _devices; }
+
   // getAddress(): copy address of device 'index' (0-based) into addr[8]. Returns true if valid.
   bool getAddress(uint8_t index, uint8_t addr[8]);
 
-  // readTemperature(): read temperature (°C) from device address; uses device's configured resolution.
+  // indexOf(): binary search of the sorted device table; returns index or -1 if not present.
+  int16_t indexOf(uint64_t rom64);
+  int16_t indexOf(const uint8_t addr[8]);
+
+  // setTagMode(): treat TH/TL EEPROM bytes as a 16-bit location tag (TH = high byte) instead of
+  // alarm thresholds. Discovery then also builds a tag-sorted index for indexOfTag().
+  void setTagMode(bool enable);
+
+  // setTag(): store 'tag' in TH/TL of device 'index' (copied to EEPROM unless persistToEeprom is false).
+  bool setTag(uint8_t index, uint16_t tag, bool persistToEeprom = true);
+
+  // getTag(): return cached tag of device 'index' (read during discovery, no bus traffic).
+  bool getTag(uint8_t index, uint16_t &tag);
+
+  // indexOfTag(): binary search of the tag index (tag mode only); returns index or -1.
+  int16_t indexOfTag(uint16_t tag);
+
+  // getDeviceInfo(): copy cached metadata of device 'index'. Returns true if index valid.
+  bool getDeviceInfo(uint8_t index, DS18B20_DeviceInfo &info);
+
+  // readTemperature(): read temperature (°C) from device address; uses device's configured resolution
+  // (a fixed resolution needs no lookup and masks the undefined low bits).
   float readTemperature(const uint8_t addr[8]);
 
   // readRawTemperature(): read raw 16-bit temperature register (signed).
   bool readRawTemperature(const uint8_t addr[8], int16_t &raw);
 
+  // readAllRaw(): read the latched temperature of every device (no conversion, see convertAll() /
+  // startConversionAll()) directly into caller-owned parallel arrays indexed like the device table:
+  // raw[i] in 1/16 °C, status[i] DS18B20_STATUS_*, timestamps[i] millis() of the read. status and
+  // timestamps may be nullptr. Fills min(getDeviceCount(), max) entries; returns how many are OK.
+  uint8_t readAllRaw(int16_t *raw, uint8_t *status, uint32_t *timestamps, uint8_t max);
+
   // setResolution(): set resolution (9..12) for device, writes to scratchpad and optionally copies to EEPROM.
   bool setResolution(const uint8_t addr[8], uint8_t resolution, bool persistToEeprom = false);
 
@@ -52,6 +270,16 @@ public:
   // alarmSearch(): finds next device in alarm state and copies its address; returns true if found.
   bool alarmSearch(uint8_t foundAddr[8]);
 
+  // verifyPresence(): directed Search ROM that only follows addr's bits - 64 triplets whatever
+  // the number of devices. Returns true if the device took part in every bit.
+  bool verifyPresence(const uint8_t addr[8]);
+
+  // verifyPresence(): batch variant; present[i] tells whether roms[i] answered. The list is walked
+  // in search order (bit 0 first, any input order works), so a ROM whose path branches off where
+  // the previous ROM's search found nobody is decided without bus traffic. Returns the number of
+  // devices present.
+  uint8_t verifyPresence(const uint8_t (*roms)[8], uint8_t count, bool *present);
+
   // isParasitePower(): returns true if device reports parasite power mode.
   bool isParasitePower(const uint8_t addr[8]);
 
@@ -67,25 +295,299 @@ public:
   // recallE2(): recall EEPROM TH/TL/config into scratchpad.
   bool recallE2(const uint8_t addr[8]);
 
+  // checkBusPower(): Skip ROM + Read Power Supply once for the whole bus; caches and returns
+  // true if any device is parasite powered. Called by begin().
+  bool checkBusPower();
+
+  // hasParasiteDevices(): cached result of checkBusPower() (true until the bus has been checked).
+  bool hasParasiteDevices();
+
+  // convertAll(): Skip ROM Convert T on all devices; holds the strong pull-up only if the bus has
+  // parasite devices and waits for the slowest cached resolution. Returns false if no presence.
+  bool convertAll();
+
   // readPowerSupply(): issues Read Power Supply command; returns true for external, false for parasite.
   bool readPowerSupply(const uint8_t addr[8], bool &externalPowered);
 
-  // getROM64(): convert address[8] to uint64_t (LSB first).
-  uint64_t getROM64(const uint8_t addr[8]);
+  // startConversion(): Match ROM Convert T without waiting. The strong pull-up (parasite device)
+  // is armed right after the last command bit. Returns false if no presence or a conversion or
+  // copy is still pending.
+  bool startConversion(const uint8_t addr[8]);
 
-  // crc8(): helper to compute 1-Wire CRC8
-  static uint8_t crc8(const uint8_t *data, uint8_t len);
+  // startConversionAll(): Skip ROM Convert T without waiting (pull-up only on parasite buses).
+  bool startConversionAll();
+
+  // isConversionComplete(): true once the pending conversion / EEPROM copy time has elapsed;
+  // releases the strong pull-up. Read the result with readRawTemperature() afterwards.
+  bool isConversionComplete();
+
+  // servicePullup(): release the strong pull-up when its deadline has passed. Safe to call from a
+  // timer ISR for precise release; isConversionComplete() calls it as well.
+  void servicePullup();
+
+  // onEvent(): register 'callback' for the DS18B20_EVENT_* bits in 'events'. Fixed slots, no heap;
+  // events are delivered from poll() and rescanDevices(). Returns false if all slots are in use.
+  bool onEvent(uint8_t events, DS18B20_EventCallback callback, void *ctx = nullptr);
+
+  // removeEventHandler(): free every slot registered with 'callback'.
+  void removeEventHandler(DS18B20_EventCallback callback);
+
+  // setSweepInterval(): period between poll()'s broadcast conversions in ms (default 1000); with
+  // the scheduler, the sampling period of devices without their own (setSchedule()).
+  void setSweepInterval(uint32_t ms);
+
+#if DS18B20_SCHEDULER
+  // setSchedule(): poll() sampling period of device 'index' in ms (0 = sweep interval,
+  // DS18B20_SCHEDULE_OFF = never read) and its priority: within a conversion higher priorities are
+  // read first. Follows the device when rescanDevices() moves it; searchDevices() resets every
+  // schedule. Returns false if index is out of range.
+  bool setSchedule(uint8_t index, uint32_t periodMs, uint8_t priority = 0);
+#endif
+
+#if DS18B20_PIPELINE
+  // setPipelined(): poll() samples continuously in two groups (even / odd table indices) instead
+  // of sweeping. A group is read as soon as its conversion completes and restarted right away
+  // (Match ROM Convert T per member), so its readout overlaps the other group's conversion. Only
+  // used on externally powered buses (checkBusPower()) with two or more devices, otherwise poll()
+  // keeps sweeping. A group is only restarted once a member is due: its setSchedule() deadline
+  // has passed (members due before the conversion completes join it), or without
+  // DS18B20_SCHEDULER one sweep interval after its last start. DS18B20_SCHEDULE_OFF devices are
+  // skipped.
+  void setPipelined(bool on);
+#endif
+
+  // setRescanInterval(): ROM search after every 'sweeps' sweeps to report added / removed
+  // devices (0 = never, the default).
+  void setRescanInterval(uint16_t sweeps);
+
+  // poll(): non-blocking sweep scheduler, call from loop(). Once the earliest deadline has passed,
+  // every device due before that conversion would complete joins it (one broadcast Convert T, or
+  // Match ROM for a lone device); only those devices are read and their events delivered.
+  // Without DS18B20_SCHEDULER all devices are read once per sweep interval. See setPipelined().
+  void poll();
+
+#if DS18B20_FILTERS
+  // setFilter(): DS18B20_FILTER_* stages applied to poll() readings of device 'index'. alphaQ8 is
+  // the EMA weight of a new sample in 1/256, maxDelta the largest accepted step in 1/16 °C.
+  // Follows the device when rescanDevices() moves it; searchDevices() clears every filter.
+  bool setFilter(uint8_t index, uint8_t mode, uint8_t alphaQ8 = 64, uint16_t maxDelta = 32);
+#endif
+
+#if DS18B20_HEALTH
+  // getHealth(): bus-health counters of device 'index'. Returns false if index is out of range.
+  bool getHealth(uint8_t index, DS18B20_Health &health);
+
+  // worstDevices(): indices of devices with a non-zero error rate, worst first; up to 'max'.
+  // Returns the number of indices written.
+  uint8_t worstDevices(uint8_t *indices, uint8_t max);
+
+  // clearHealth(): reset the counters of all devices.
+  void clearHealth();
+
+  // searchErrors(): ROMs dropped by the CRC check during searches (not tied to a device).
+  uint16_t searchErrors() const { return _searchErrors; }
+#endif
+
+#if DS18B20_LATENCY
+  // getLatency(): histogram of operation 'op' (DS18B20_LAT_*). Returns false if op is invalid.
+  bool getLatency(uint8_t op, DS18B20_Histogram &histogram);
+
+  // clearLatency(): reset all histograms.
+  void clearLatency();
+#endif
+
+  // setTrace(): record strong pull-up and conversion-wait events into 'trace' (nullptr = off); use
+  // the same trace for a DS18B20_TraceBusT around the bus to get the complete picture.
+  void setTrace(DS18B20_Trace *trace) { _trace = trace; }
+
+  // rescanDevices(): ROM search diffed against the device table. Missing devices are confirmed
+  // by a scratchpad read before REMOVED fires; new devices get ADDED. Returns the device count.
+  uint8_t rescanDevices();
+
+  // ROM64 variants of the per-device APIs (same behaviour as the address[8] versions).
+  float readTemperature(uint64_t rom64);
+  bool readRawTemperature(uint64_t rom64, int16_t &raw);
+  bool setResolution(uint64_t rom64, uint8_t resolution, bool persistToEeprom = false);
+  uint8_t getResolution(uint64_t rom64);
+  bool setAlarms(uint64_t rom64, int8_t th, int8_t tl, bool persistToEeprom = false);
+  bool getAlarms(uint64_t rom64, int8_t &th, int8_t &tl);
+  bool isParasitePower(uint64_t rom64);
+  bool verifyPresence(uint64_t rom64);
 
 private:
-  OneWire oneWire;
+  typedef DS18B20_Resolution<Config::resolution> _Res;
+
+  // columns of compiled-out features keep one placeholder entry (no zero-length arrays)
+  static const uint8_t _RES_SLOTS = Config::resolution ? 1 : Config::maxDevices;
+  static const uint8_t _ALARM_SLOTS = Config::alarms ? Config::maxDevices : 1;
+  // ROM bytes per entry: family + 48-bit serial when compact, the CRC is recomputed on use
+  static const uint8_t _ROM_BYTES = Config::compactRom ? 7 : 8;
+
+  Bus &_bus;
   uint8_t _devices;
-  uint8_t _addresses[DS18B20_MAX_DEVICES][8];
-  int8_t _strongPullupPin;
-  uint8_t _dataPin;
+  uint8_t _addresses[Config::maxDevices][_ROM_BYTES];
+  uint8_t _resolution[_RES_SLOTS];
+  int8_t _th[_ALARM_SLOTS];
+  int8_t _tl[_ALARM_SLOTS];
+  uint8_t _flags[Config::maxDevices];
+  uint8_t _tagOrder[_ALARM_SLOTS];  // device indices sorted by tag (tag mode)
+#if DS18B20_FILTERS
+  DS18B20_Filter _filter[Config::maxDevices];
+#endif
+#if DS18B20_HEALTH
+  DS18B20_Health _health[Config::maxDevices];
+  uint16_t _searchErrors;
+#endif
+#if DS18B20_LATENCY
+  DS18B20_Histogram _latency[DS18B20_LAT_COUNT];
+#endif
+  DS18B20_Trace *_trace;
+  bool _tagMode;
+  bool _busParasite;  // any parasite device on the bus (checkBusPower)
+  typename DS18B20_Select<Config::parasite, DS18B20_FastPin, DS18B20_NoPin>::type _strongPullupPin;  // cached port register / mask
+  DS18B20_CacheStore *_cacheStore;
+
+  // asynchronous conversion / strong pull-up state (deadline in micros)
+  volatile uint32_t _convStart;
+  volatile uint32_t _convUs;
+  volatile bool _pullupOn;
+  bool _pullupTraced;  // pull-up "on" traced, "off" still to be recorded (main line only)
+  bool _convPending;
+
+  // event callbacks and sweep scheduler
+  struct _Listener {
+    DS18B20_EventCallback callback;
+    void *ctx;
+    uint8_t events;
+  };
+  _Listener _listeners[DS18B20_MAX_CALLBACKS];
+  uint32_t _sweepInterval;
+  uint32_t _lastSweep;
+#if DS18B20_SCHEDULER
+  uint32_t _period[Config::maxDevices];    // 0 = sweep interval
+  uint32_t _deadline[Config::maxDevices];  // millis() of the next reading
+  uint8_t _priority[Config::maxDevices];
+#endif
+#if DS18B20_PIPELINE
+  bool _pipelined;
+  uint8_t _pipeBusy;        // bit g: group g is converting
+  uint32_t _pipeStart[2];   // millis() after the group's last Convert T
+  uint16_t _pipeMs[2];      // conversion time of the group's slowest member
+#endif
+  uint16_t _rescanSweeps;
+  uint16_t _sweepCount;
+  uint8_t _sweepState;
+  uint8_t _reconvertIndex;
 
   // internal helpers
+  DS18B20_Script &_address(DS18B20_Script &script, const uint8_t addr[8]);
+  const uint8_t *_rom(uint8_t index, uint8_t buf[8]);
+  void _copyRom(uint8_t index, uint8_t rom[8]);
+  void _setRom(uint8_t index, const uint8_t rom[8]);
+  bool _nextRom(uint8_t rom[8], bool first);
+  uint8_t _tableResolution(uint8_t index);
+  void _storeMetadata(uint8_t index, uint8_t resolution, int8_t th, int8_t tl);
+  bool _enforceResolution(uint8_t index, const uint8_t sp[9]);
+  void _buildTagIndex();
+  bool _isExternalPowered(const uint8_t addr[8]);
+  void _sortTable();
+  void _swapEntries(uint8_t a, uint8_t b);
+  bool _cacheMetadata(uint8_t index);
+  bool _verifyCachedDevices();
   void _strongPullup(bool on);
-  uint16_t _conversionDelayMs(uint8_t resolution);
+  void _armConversion(uint16_t ms, bool pullup);
+  void _waitConversion();
+  uint8_t _cachedResolution(const uint8_t addr[8]);
+  bool _readChecked(const uint8_t addr[8], uint8_t buffer[9], uint8_t &verdict);
+  static uint8_t _classifyChecked(const uint8_t sp[9], uint8_t verdict);
+  void _recordRead(const uint8_t addr[8], uint8_t status);
+  uint8_t _readClassified(const uint8_t addr[8], int16_t &raw);
+  uint8_t _directedSearch(const uint8_t rom[8]);
+  uint8_t _collectDue(uint8_t &single);
+#if DS18B20_SCHEDULER
+  void _advanceDeadline(uint8_t index, uint32_t now);
+#endif
+  uint16_t _sweepDelayMs();
+  void _readSweep(uint8_t first = 0, uint8_t step = 1);
+#if DS18B20_PIPELINE
+  void _pollPipeline();
+  bool _startGroup(uint8_t group);
+#endif
+  void _deliverReading(uint8_t index, uint8_t status, int16_t raw);
+  bool _startReconvert();
+  void _emit(uint8_t type, uint8_t index, uint8_t status, int16_t raw);
+  void _removeEntry(uint8_t index, uint8_t used);
+  void _recordHealth(const uint8_t addr[8], uint8_t event);
+};
+
+#if defined(ARDUINO)
+// DS18B20_OneWireBus: default transport, thin inline wrapper around the OneWire library.
+class DS18B20_OneWireBus {
+public:
+  explicit DS18B20_OneWireBus(uint8_t dataPin)
+    : _ow(dataPin) {}
+
+  uint8_t reset() { return _ow.reset(); }
+  void writeBit(uint8_t v) { _ow.write_bit(v); }
+  uint8_t readBit() { return _ow.read_bit(); }
+  uint8_t triplet(uint8_t direction) {
+    uint8_t idBit = _ow.read_bit();
+    uint8_t cmpBit = _ow.read_bit();
+    if (idBit != cmpBit) direction = idBit;
+    else if (idBit) return 0x03;  // nobody answered: no write slot
+    _ow.write_bit(direction);
+    return (uint8_t)(idBit | (cmpBit << 1) | (direction << 2));
+  }
+  void select(const uint8_t rom[8]) { _ow.select(rom); }
+  void skip() { _ow.skip(); }
+  void write(uint8_t v, uint8_t power = 0) { _ow.write(v, power); }
+  uint8_t read() { return _ow.read(); }
+  void writeBytes(const uint8_t *buf, uint16_t len, uint8_t power = 0) { _ow.write_bytes(buf, len, power); }
+  void readBytes(uint8_t *buf, uint16_t len) { _ow.read_bytes(buf, len); }
+  void flush() {}
+  void depower() { _ow.depower(); }
+  void resetSearch() { _ow.reset_search(); }
+  bool search(uint8_t rom[8], bool alarmOnly = false) { return _ow.search(rom, !alarmOnly); }
+  bool execute(const DS18B20_Script &script, uint8_t *rx) { return DS18B20_Script::run(*this, script, rx); }
+
+  // oneWire(): underlying OneWire instance.
+  OneWire &oneWire() { return _ow; }
+
+private:
+  OneWire _ow;
 };
 
+// DS18B20_OneWireHolder: owns the OneWire transport so it is constructed before the driver.
+struct DS18B20_OneWireHolder {
+  explicit DS18B20_OneWireHolder(uint8_t dataPin)
+    : _oneWireBus(dataPin) {}
+  DS18B20_OneWireBus _oneWireBus;
+};
+
+// DS18B20_7semi: DS18B20 driver on a bit-banged OneWire pin (no virtual calls).
+class DS18B20_7semi : private DS18B20_OneWireHolder, public DS18B20_Driver<DS18B20_OneWireBus> {
+public:
+  // Constructor: dataPin is the 1-Wire bus pin. strongPullupPin optional for parasite power.
+  // Inline, like the rest of the driver, so the sketch's DS18B20_* switches decide the layout.
+  DS18B20_7semi(uint8_t dataPin, int8_t strongPullupPin = -1)
+    : DS18B20_OneWireHolder(dataPin), DS18B20_Driver<DS18B20_OneWireBus>(_oneWireBus, strongPullupPin) {
+    _dataPin = dataPin;
+  }
+
+private:
+  uint8_t _dataPin;
+};
+
+// DS18B20_7semiT: DS18B20_7semi with a feature policy, e.g. DS18B20_7semiT<DS18B20_SingleDevice<> >.
+template <class Config>
+class DS18B20_7semiT : private DS18B20_OneWireHolder, public DS18B20_Driver<DS18B20_OneWireBus, Config> {
+public:
+  DS18B20_7semiT(uint8_t dataPin, int8_t strongPullupPin = -1)
+    : DS18B20_OneWireHolder(dataPin), DS18B20_Driver<DS18B20_OneWireBus, Config>(_oneWireBus, strongPullupPin) {}
+};
+#endif
+
+#include "7semi_DS18B20_impl.h"
+
+
 #endif
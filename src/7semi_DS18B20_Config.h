@@ -0,0 +1,122 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Config.h - compile-time feature policies for DS18B20_Driver<Bus, Config>
+//  Written for the 7semi sensor platform
+//
+//  The second template argument of DS18B20_Driver selects the features that are compiled in.
+//  Policies derive from each other, so they can be stacked:
+//
+//    DS18B20_Driver<Bus, DS18B20_SingleDevice<DS18B20_NoParasite<DS18B20_NoAlarms<> > > >
+//
+//  Disabled features cost no RAM (table columns shrink to one placeholder entry, the strong
+//  pull-up pin becomes an empty object) and no flash: every check is on a compile-time constant,
+//  so the dead branches and the helpers only they call are never emitted. The affected API
+//  calls stay available and return false (or a neutral value).
+//
+//    DS18B20_NoParasite         no Read Power Supply queries, no strong pull-up pin
+//    DS18B20_NoAlarms           no TH/TL cache, alarm search, ALARM events or TH/TL tags
+//    DS18B20_NoEeprom           no Copy Scratchpad / Recall E2 (persistToEeprom fails)
+//    DS18B20_NoVerify           Write Scratchpad without the read-back check
+//    DS18B20_FixedResolution<N> every device converts at N bits; no per-device resolution column
+//    DS18B20_SingleDevice       one device: Read ROM instead of the search, Skip ROM addressing
+//    DS18B20_CompactRom         7 instead of 8 address bytes per device (CRC byte rebuilt on use)
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_CONFIG_H_
+#define _7SEMI_DS18B20_CONFIG_H_
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include "7semi_DS18B20_Host.h"
+#endif
+
+#ifndef DS18B20_MAX_DEVICES
+#define DS18B20_MAX_DEVICES 16
+#endif
+
+// DS18B20_DefaultConfig: every feature enabled, DS18B20_MAX_DEVICES table entries.
+struct DS18B20_DefaultConfig {
+  static const bool parasite = true;      // parasite power detection and strong pull-up
+  static const bool alarms = true;        // TH/TL cache, alarm search / events, tags
+  static const bool eeprom = true;        // Copy Scratchpad / Recall E2
+  static const bool verifyWrites = true;  // read back Write Scratchpad
+  static const uint8_t resolution = 0;    // 9..12 = fixed for all devices, 0 = per device
+  static const uint8_t maxDevices = DS18B20_MAX_DEVICES;  // 1 = single device, Skip ROM
+  static const bool compactRom = false;   // store family + serial only
+};
+
+template <class Base = DS18B20_DefaultConfig>
+struct DS18B20_NoParasite : Base {
+  static const bool parasite = false;
+};
+
+template <class Base = DS18B20_DefaultConfig>
+struct DS18B20_NoAlarms : Base {
+  static const bool alarms = false;
+};
+
+template <class Base = DS18B20_DefaultConfig>
+struct DS18B20_NoEeprom : Base {
+  static const bool eeprom = false;
+};
+
+template <class Base = DS18B20_DefaultConfig>
+struct DS18B20_NoVerify : Base {
+  static const bool verifyWrites = false;
+};
+
+template <uint8_t Bits, class Base = DS18B20_DefaultConfig>
+struct DS18B20_FixedResolution : Base {
+  static_assert(Bits >= 9 && Bits <= 12, "DS18B20 resolution is 9..12 bits");
+  static const uint8_t resolution = Bits;
+};
+
+template <class Base = DS18B20_DefaultConfig>
+struct DS18B20_SingleDevice : Base {
+  static const uint8_t maxDevices = 1;
+};
+
+template <class Base = DS18B20_DefaultConfig>
+struct DS18B20_CompactRom : Base {
+  static const bool compactRom = true;
+};
+
+// DS18B20_Resolution<Bits>: conversion constants of a fixed resolution (9..12). The runtime
+// resolution arguments are ignored, so every use folds into a constant.
+template <uint8_t Bits>
+struct DS18B20_Resolution {
+  static constexpr uint8_t bits(uint8_t) { return Bits; }
+  // Convert T time, 750 ms at 12 bits halved per bit less (rounded up)
+  static constexpr uint16_t delayMs(uint8_t) { return (750 + (1 << (12 - Bits)) - 1) >> (12 - Bits); }
+  // configuration register: 0 R1 R0 1 1 1 1 1
+  static constexpr uint8_t config(uint8_t) { return (uint8_t)(((Bits - 9) << 5) | 0x1F); }
+  // temperature register bits below the resolution are undefined
+  static constexpr int16_t lsbMask() { return (int16_t)~((1 << (12 - Bits)) - 1); }
+  static constexpr float celsius(int16_t raw) { return (int16_t)(raw & lsbMask()) * 0.0625f; }
+};
+
+// DS18B20_Resolution<0>: per-device resolution, resolved at run time (unknown values mean 12).
+template <>
+struct DS18B20_Resolution<0> {
+  static uint8_t bits(uint8_t res) { return (res < 9 || res > 12) ? 12 : res; }
+  static uint16_t delayMs(uint8_t res) { return (750 + (1 << (12 - bits(res))) - 1) >> (12 - bits(res)); }
+  static uint8_t config(uint8_t res) { return (uint8_t)(((bits(res) - 9) << 5) | 0x1F); }
+  // devices at lower resolutions clear the undefined bits in practice; the raw value is kept
+  static float celsius(int16_t raw) { return raw * 0.0625f; }
+};
+
+// DS18B20_Select: T if Enabled, otherwise the stand-in F (type of optional members).
+template <bool Enabled, class T, class F>
+struct DS18B20_Select {
+  typedef T type;
+};
+
+template <class T, class F>
+struct DS18B20_Select<false, T, F> {
+  typedef F type;
+};
+
+#endif
@@ -0,0 +1,175 @@
+/***************************************************************************************************
+//  7semi_DS18B20_DS2482.h - DS2482-100/-800 I2C-to-1-Wire bridge transport
+//  Written for the 7semi sensor platform
+//
+//  The bridge generates all 1-Wire slots in hardware (1WRS, 1WWB, 1WRB, 1WSB, 1WT), so
+//  interrupts stay enabled and the MCU only polls the status register over I2C, calling
+//  yield() between polls. Searches use the 1WT triplet command (one I2C command per ROM bit).
+//  Each DS18B20_DS2482T object drives one channel; on the DS2482-800 create one per channel
+//  (0..7) and use them as separate buses. Use channel -1 for the single-channel DS2482-100.
+//
+//  'I2C' is any class with the TwoWire interface (beginTransmission/write/endTransmission/
+//  requestFrom/read); DS18B20_DS2482 is the TwoWire variant on Arduino.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_DS2482_H_
+#define _7SEMI_DS18B20_DS2482_H_
+
+#include "7semi_DS18B20_Transport.h"
+#if defined(ARDUINO)
+#include <Wire.h>
+#endif
+
+// DS2482 commands
+#define DS2482_CMD_DRST 0xF0  // device reset
+#define DS2482_CMD_SRP 0xE1   // set read pointer
+#define DS2482_CMD_WCFG 0xD2  // write configuration
+#define DS2482_CMD_CHSL 0xC3  // channel select (-800 only)
+#define DS2482_CMD_1WRS 0xB4  // 1-Wire reset
+#define DS2482_CMD_1WSB 0x87  // 1-Wire single bit
+#define DS2482_CMD_1WWB 0xA5  // 1-Wire write byte
+#define DS2482_CMD_1WRB 0x96  // 1-Wire read byte
+#define DS2482_CMD_1WT 0x78   // 1-Wire triplet
+
+// read pointer codes
+#define DS2482_PTR_STATUS 0xF0
+#define DS2482_PTR_DATA 0xE1
+#define DS2482_PTR_CONFIG 0xC3
+#define DS2482_PTR_CHANNEL 0xD2
+
+// status register bits
+#define DS2482_STATUS_1WB 0x01  // 1-Wire busy
+#define DS2482_STATUS_PPD 0x02  // presence pulse detected
+#define DS2482_STATUS_SD 0x04   // short detected
+#define DS2482_STATUS_RST 0x10  // device reset occurred
+#define DS2482_STATUS_SBR 0x20  // single bit result
+#define DS2482_STATUS_TSB 0x40  // triplet second bit
+#define DS2482_STATUS_DIR 0x80  // branch direction taken
+
+// configuration register bits
+#define DS2482_CFG_APU 0x01  // active pull-up
+#define DS2482_CFG_SPU 0x04  // strong pull-up after next byte/bit
+#define DS2482_CFG_1WS 0x08  // overdrive speed
+
+// status polls before a command is considered failed
+#define DS2482_POLL_LIMIT 200
+
+template <class I2C>
+class DS18B20_DS2482T : public DS18B20_Transport {
+public:
+  // Constructor: i2cAddress 0x18..0x1F; channel 0..7 on the DS2482-800, -1 on the DS2482-100.
+  DS18B20_DS2482T(I2C &wire, uint8_t i2cAddress = 0x18, int8_t channel = -1)
+    : _wire(wire), _addr(i2cAddress), _channel(channel), _config(DS2482_CFG_APU), _status(0) {}
+
+  // begin(): reset the bridge and write the configuration (active pull-up on).
+  // Returns false if the bridge does not answer.
+  bool begin() {
+    if (!_command(DS2482_CMD_DRST)) return false;
+    if (!(_readRegister() & DS2482_STATUS_RST)) return false;
+    return _writeConfig(_config);
+  }
+
+  // status(): status register value after the last completed 1-Wire command.
+  uint8_t status() const { return _status; }
+
+  uint8_t reset() override {
+    if (_channel >= 0 && !_selectChannel()) return 0;
+    if (!_command(DS2482_CMD_1WRS) || !_waitIdle()) return 0;
+    if (_status & DS2482_STATUS_SD) return 0;  // bus shorted
+    return (_status & DS2482_STATUS_PPD) ? 1 : 0;
+  }
+
+  void writeBit(uint8_t v) override {
+    _command(DS2482_CMD_1WSB, v ? 0x80 : 0x00);
+    _waitIdle();
+  }
+
+  uint8_t readBit() override {
+    _command(DS2482_CMD_1WSB, 0x80);  // a read slot is a write-1 slot
+    if (!_waitIdle()) return 1;
+    return (_status & DS2482_STATUS_SBR) ? 1 : 0;
+  }
+
+  void write(uint8_t v, uint8_t power = 0) override {
+    if (power) _writeConfig(_config | DS2482_CFG_SPU);  // SPU applies to the next byte
+    _command(DS2482_CMD_1WWB, v);
+    _waitIdle();
+  }
+
+  uint8_t read() override {
+    _command(DS2482_CMD_1WRB);
+    if (!_waitIdle()) return 0xFF;
+    if (!_command(DS2482_CMD_SRP, DS2482_PTR_DATA)) return 0xFF;
+    return _readRegister();
+  }
+
+  void depower() override {
+    _writeConfig(_config);  // clearing SPU ends the strong pull-up
+  }
+
+  uint8_t triplet(uint8_t direction) override {
+    _command(DS2482_CMD_1WT, direction ? 0x80 : 0x00);
+    if (!_waitIdle()) return 0x03;
+    return (uint8_t)(((_status & DS2482_STATUS_SBR) ? 0x01 : 0) | ((_status & DS2482_STATUS_TSB) ? 0x02 : 0) | ((_status & DS2482_STATUS_DIR) ? 0x04 : 0));
+  }
+
+private:
+  I2C &_wire;
+  uint8_t _addr;
+  int8_t _channel;
+  uint8_t _config;
+  uint8_t _status;
+
+  // _command(): send command byte (and optional parameter); read pointer moves to status
+  bool _command(uint8_t cmd) {
+    _wire.beginTransmission(_addr);
+    _wire.write(cmd);
+    return _wire.endTransmission() == 0;
+  }
+
+  bool _command(uint8_t cmd, uint8_t param) {
+    _wire.beginTransmission(_addr);
+    _wire.write(cmd);
+    _wire.write(param);
+    return _wire.endTransmission() == 0;
+  }
+
+  // _readRegister(): read the register selected by the read pointer
+  uint8_t _readRegister() {
+    if (_wire.requestFrom(_addr, (uint8_t)1) != 1) return 0xFF;
+    return (uint8_t)_wire.read();
+  }
+
+  // _waitIdle(): poll status until 1WB clears; the CPU is free between polls
+  bool _waitIdle() {
+    for (uint16_t i = 0; i < DS2482_POLL_LIMIT; i++) {
+      _status = _readRegister();
+      if (!(_status & DS2482_STATUS_1WB)) return true;
+      yield();
+    }
+    return false;
+  }
+
+  // _writeConfig(): upper nibble must be the complement of the lower nibble
+  bool _writeConfig(uint8_t cfg) {
+    if (!_command(DS2482_CMD_WCFG, (uint8_t)((cfg & 0x0F) | ((~cfg & 0x0F) << 4)))) return false;
+    return (_readRegister() & 0x0F) == (cfg & 0x0F);
+  }
+
+  // _selectChannel(): route the -800 bridge to this object's channel
+  bool _selectChannel() {
+    static const uint8_t code[8] = { 0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87 };
+    static const uint8_t readback[8] = { 0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87 };
+    if (!_command(DS2482_CMD_CHSL, code[_channel & 0x07])) return false;
+    return _readRegister() == readback[_channel & 0x07];
+  }
+};
+
+#if defined(ARDUINO)
+typedef DS18B20_DS2482T<TwoWire> DS18B20_DS2482;
+#endif
+
+#endif
@@ -0,0 +1,175 @@
+/***************************************************************************************************
+//  7semi_DS18B20_DS2482Sim.h - DS2482-100/-800 register model for host testing
+//  Written for the 7semi sensor platform
+//
+//  Provides the TwoWire subset used by DS18B20_DS2482T and models the bridge's status, data,
+//  configuration and channel registers. 1-Wire commands are forwarded to the transport attached
+//  to the selected channel (e.g. a DS18B20_SimBus), and each command reports 1WB busy for a
+//  configurable number of status polls.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_DS2482SIM_H_
+#define _7SEMI_DS18B20_DS2482SIM_H_
+
+#include "7semi_DS18B20_DS2482.h"
+
+class DS18B20_DS2482Sim {
+public:
+  explicit DS18B20_DS2482Sim(uint8_t i2cAddress = 0x18)
+    : i2cTransactions(0), _addr(i2cAddress), _len(0), _busyPolls(1), _pending(0) {
+    for (uint8_t i = 0; i < 8; i++) _bus[i] = nullptr;
+    _deviceReset();
+  }
+
+  // attach(): connect a 1-Wire transport to channel 0..7 (channel 0 for the DS2482-100).
+  void attach(uint8_t channel, DS18B20_Transport *bus) { _bus[channel & 0x07] = bus; }
+
+  // setBusyPolls(): status reads reporting 1WB after each 1-Wire command.
+  void setBusyPolls(uint8_t polls) { _busyPolls = polls; }
+
+  // TwoWire subset
+  void beginTransmission(uint8_t address) {
+    _txAddr = address;
+    _len = 0;
+  }
+
+  size_t write(uint8_t b) {
+    if (_len < sizeof(_buf)) _buf[_len++] = b;
+    return 1;
+  }
+
+  uint8_t endTransmission(bool stop = true) {
+    (void)stop;
+    i2cTransactions++;
+    if (_txAddr != _addr) return 2;  // address NACK
+    if (_len == 0) return 0;
+    return _execute() ? 0 : 3;  // data NACK on invalid command
+  }
+
+  uint8_t requestFrom(uint8_t address, uint8_t count) {
+    i2cTransactions++;
+    return (address == _addr) ? count : 0;
+  }
+
+  int read() {
+    switch (_ptr) {
+      case DS2482_PTR_STATUS:
+        if (_pending) {
+          _pending--;
+          return _status | DS2482_STATUS_1WB;
+        }
+        return _status;
+      case DS2482_PTR_DATA: return _data;
+      case DS2482_PTR_CONFIG: return _config;
+      case DS2482_PTR_CHANNEL: {
+        static const uint8_t readback[8] = { 0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87 };
+        return readback[_channel];
+      }
+    }
+    return 0xFF;
+  }
+
+  uint32_t i2cTransactions;  // I2C writes + reads seen by the model
+
+private:
+  DS18B20_Transport *_bus[8];
+  uint8_t _addr;
+  uint8_t _txAddr;
+  uint8_t _buf[2];
+  uint8_t _len;
+  uint8_t _busyPolls;
+  uint8_t _pending;
+  uint8_t _ptr;
+  uint8_t _status;
+  uint8_t _data;
+  uint8_t _config;
+  uint8_t _channel;
+
+  void _deviceReset() {
+    _status = DS2482_STATUS_RST;
+    _config = 0;
+    _channel = 0;
+    _data = 0;
+    _ptr = DS2482_PTR_STATUS;
+  }
+
+  // _wire(): 1-Wire side of the bridge, marks the command busy for the next status polls
+  DS18B20_Transport *_wire() {
+    _ptr = DS2482_PTR_STATUS;
+    _pending = _busyPolls;
+    _status &= (uint8_t)~(DS2482_STATUS_RST | DS2482_STATUS_SBR | DS2482_STATUS_TSB | DS2482_STATUS_DIR);
+    return _bus[_channel];
+  }
+
+  bool _execute() {
+    uint8_t param = (_len > 1) ? _buf[1] : 0;
+    switch (_buf[0]) {
+      case DS2482_CMD_DRST:
+        _deviceReset();
+        return true;
+      case DS2482_CMD_SRP:
+        if (param != DS2482_PTR_STATUS && param != DS2482_PTR_DATA && param != DS2482_PTR_CONFIG && param != DS2482_PTR_CHANNEL) return false;
+        _ptr = param;
+        return true;
+      case DS2482_CMD_WCFG:
+        if ((uint8_t)(param >> 4) != (uint8_t)(~param & 0x0F)) return false;
+        _config = param & 0x0F;
+        _ptr = DS2482_PTR_CONFIG;
+        return true;
+      case DS2482_CMD_CHSL: {
+        static const uint8_t code[8] = { 0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87 };
+        for (uint8_t i = 0; i < 8; i++) {
+          if (code[i] == param) {
+            _channel = i;
+            _ptr = DS2482_PTR_CHANNEL;
+            return true;
+          }
+        }
+        return false;
+      }
+      case DS2482_CMD_1WRS: {
+        DS18B20_Transport *bus = _wire();
+        _status &= (uint8_t)~DS2482_STATUS_PPD;
+        if (bus && bus->reset()) _status |= DS2482_STATUS_PPD;
+        return true;
+      }
+      case DS2482_CMD_1WSB: {
+        DS18B20_Transport *bus = _wire();
+        uint8_t bit = 0;
+        if (!(param & 0x80)) {
+          if (bus) bus->writeBit(0);
+        } else {
+          bit = bus ? bus->readBit() : 1;  // write-1 slot samples the bus
+        }
+        if (bit) _status |= DS2482_STATUS_SBR;
+        return true;
+      }
+      case DS2482_CMD_1WWB: {
+        DS18B20_Transport *bus = _wire();
+        if (bus) bus->write(param);
+        _config &= (uint8_t)~DS2482_CFG_SPU;  // strong pull-up consumed by this byte
+        return true;
+      }
+      case DS2482_CMD_1WRB: {
+        DS18B20_Transport *bus = _wire();
+        _data = bus ? bus->read() : 0xFF;
+        return true;
+      }
+      case DS2482_CMD_1WT: {
+        DS18B20_Transport *bus = _wire();
+        uint8_t t = bus ? bus->triplet((param & 0x80) ? 1 : 0) : 0x07;
+        if ((t & 0x03) == 0x03) t |= 0x04;  // bridge writes a 1 when nobody answered
+        if (t & 0x01) _status |= DS2482_STATUS_SBR;
+        if (t & 0x02) _status |= DS2482_STATUS_TSB;
+        if (t & 0x04) _status |= DS2482_STATUS_DIR;
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+#endif
@@ -0,0 +1,50 @@
+/*************************************************************************************************** 
+//  7semi_DS18B20_EEPROMStore.h - Arduino EEPROM backing store for the DS18B20 device table cache
+//  Written for the 7semi sensor platform
+//
+//  Include this header explicitly on boards that ship the EEPROM library.
+//  On ESP8266/ESP32 call EEPROM.begin(size) before begin(); writes are committed automatically.
+// 
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_EEPROMSTORE_H_
+#define _7SEMI_DS18B20_EEPROMSTORE_H_
+
+#include <EEPROM.h>
+#include "7semi_DS18B20.h"
+
+class DS18B20_EEPROMStore : public DS18B20_CacheStore {
+public:
+  // baseAddress: first EEPROM byte used; the cache needs DS18B20_CACHE_SIZE bytes.
+  explicit DS18B20_EEPROMStore(uint16_t baseAddress = 0)
+    : _base(baseAddress) {}
+
+  bool read(uint16_t offset, uint8_t *data, uint16_t len) override {
+    for (uint16_t i = 0; i < len; i++) data[i] = EEPROM.read(_base + offset + i);
+    return true;
+  }
+
+  bool write(uint16_t offset, const uint8_t *data, uint16_t len) override {
+    bool changed = false;
+    for (uint16_t i = 0; i < len; i++) {
+      // only touch cells that differ to save EEPROM wear
+      if (EEPROM.read(_base + offset + i) != data[i]) {
+        EEPROM.write(_base + offset + i, data[i]);
+        changed = true;
+      }
+    }
+#if defined(ESP8266) || defined(ESP32)
+    if (changed) return EEPROM.commit();
+#else
+    (void)changed;
+#endif
+    return true;
+  }
+
+private:
+  uint16_t _base;
+};
+
+#endif
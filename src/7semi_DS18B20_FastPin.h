@@ -0,0 +1,116 @@
+/***************************************************************************************************
+//  7semi_DS18B20_FastPin.h - direct register output for the strong pull-up pin
+//  Written for the 7semi sensor platform
+//
+//  The datasheet requires the strong pull-up within 10 us of the last Convert T / Copy Scratchpad
+//  bit. digitalWrite() spends several microseconds in pin lookup tables on AVR, so the port
+//  register and bitmask are resolved once and toggled directly afterwards. Register access uses
+//  the DIRECT_* macros that OneWire already provides for each architecture
+//  (OneWire_direct_gpio.h); platforms without them, and host builds, fall back to
+//  pinMode()/digitalWrite().
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_FASTPIN_H_
+#define _7SEMI_DS18B20_FASTPIN_H_
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include <OneWire.h>
+#else
+#include "7semi_DS18B20_Host.h"
+#endif
+
+#if defined(ARDUINO) && defined(PIN_TO_BASEREG) && defined(PIN_TO_BITMASK) && defined(DIRECT_WRITE_HIGH) && defined(DIRECT_WRITE_LOW) && defined(DIRECT_MODE_OUTPUT)
+#define DS18B20_FASTPIN_DIRECT 1
+#else
+#define DS18B20_FASTPIN_DIRECT 0
+#endif
+
+// PORTx read-modify-write on AVR is not atomic; keep the caller's interrupt state because
+// servicePullup() may run inside a timer ISR. Other architectures use set/clear registers.
+#if defined(__AVR__)
+#define DS18B20_FASTPIN_BEGIN_ATOMIC \
+  { \
+    uint8_t _sreg = SREG; \
+    cli();
+#define DS18B20_FASTPIN_END_ATOMIC \
+  SREG = _sreg; \
+  }
+#else
+#define DS18B20_FASTPIN_BEGIN_ATOMIC {
+#define DS18B20_FASTPIN_END_ATOMIC }
+#endif
+
+class DS18B20_FastPin {
+public:
+  // Constructor: resolve register and mask once; pin < 0 disables the pin.
+  explicit DS18B20_FastPin(int8_t pin)
+    : _pin(pin), _output(false) {
+#if DS18B20_FASTPIN_DIRECT
+    if (pin >= 0) {
+      _reg = PIN_TO_BASEREG(pin);
+      _mask = PIN_TO_BITMASK(pin);
+    }
+#endif
+  }
+
+  // output(): switch the pin to output, driven LOW. Done on first use if not called before.
+  void output() {
+    if (_pin < 0) return;
+#if DS18B20_FASTPIN_DIRECT
+    _set(false);
+    DS18B20_FASTPIN_BEGIN_ATOMIC
+    DIRECT_MODE_OUTPUT(_reg, _mask);
+    DS18B20_FASTPIN_END_ATOMIC
+#else
+    digitalWrite(_pin, LOW);
+    pinMode(_pin, OUTPUT);
+#endif
+    _output = true;
+  }
+
+  // write(): drive the pin HIGH (true) or LOW (false).
+  void write(bool high) {
+    if (_pin < 0) return;
+    if (!_output) output();
+#if DS18B20_FASTPIN_DIRECT
+    _set(high);
+#else
+    digitalWrite(_pin, high ? HIGH : LOW);
+#endif
+  }
+
+  int8_t pin() const { return _pin; }
+
+private:
+  int8_t _pin;
+  bool _output;
+#if DS18B20_FASTPIN_DIRECT
+  IO_REG_TYPE _mask;
+  volatile IO_REG_TYPE *_reg;
+
+  void _set(bool high) {
+    DS18B20_FASTPIN_BEGIN_ATOMIC
+    if (high) {
+      DIRECT_WRITE_HIGH(_reg, _mask);
+    } else {
+      DIRECT_WRITE_LOW(_reg, _mask);
+    }
+    DS18B20_FASTPIN_END_ATOMIC
+  }
+#endif
+};
+
+// DS18B20_NoPin: empty stand-in for the strong pull-up pin when parasite support is compiled out.
+class DS18B20_NoPin {
+public:
+  explicit DS18B20_NoPin(int8_t) {}
+  void output() {}
+  void write(bool) {}
+  int8_t pin() const { return -1; }
+};
+
+#endif
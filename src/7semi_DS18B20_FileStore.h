@@ -0,0 +1,44 @@
+/*************************************************************************************************** 
+//  7semi_DS18B20_FileStore.h - stdio file backing store for the DS18B20 device table cache
+//  Written for the 7semi sensor platform
+//
+//  For hosts and cores with a C stdio file system (Linux gateways, ESP32 VFS, ...).
+//  The file is created on the first write.
+// 
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_FILESTORE_H_
+#define _7SEMI_DS18B20_FILESTORE_H_
+
+#include <stdio.h>
+#include "7semi_DS18B20.h"
+
+class DS18B20_FileStore : public DS18B20_CacheStore {
+public:
+  explicit DS18B20_FileStore(const char *path)
+    : _path(path) {}
+
+  bool read(uint16_t offset, uint8_t *data, uint16_t len) override {
+    FILE *f = fopen(_path, "rb");
+    if (!f) return false;
+    bool ok = fseek(f, offset, SEEK_SET) == 0 && fread(data, 1, len, f) == len;
+    fclose(f);
+    return ok;
+  }
+
+  bool write(uint16_t offset, const uint8_t *data, uint16_t len) override {
+    FILE *f = fopen(_path, "r+b");
+    if (!f) f = fopen(_path, "w+b");  // first write creates the file
+    if (!f) return false;
+    bool ok = fseek(f, offset, SEEK_SET) == 0 && fwrite(data, 1, len, f) == len;
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+  }
+
+private:
+  const char *_path;
+};
+
+#endif
@@ -0,0 +1,85 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Filter.cpp - per-device filter stage implementation
+//  Written for the 7semi sensor platform
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "7semi_DS18B20_Filter.h"
+
+/**
+// Constructor: no stages selected
+**/
+DS18B20_Filter::DS18B20_Filter()
+  : _maxDelta(0), _mode(DS18B20_FILTER_NONE), _alpha(0) {
+  reset();
+}
+
+/**
+// configure(): store stage selection and parameters, start over
+**/
+void DS18B20_Filter::configure(uint8_t mode, uint8_t alphaQ8, uint16_t maxDelta) {
+  _mode = mode;
+  _alpha = alphaQ8 ? alphaQ8 : 1;
+  _maxDelta = maxDelta;
+  reset();
+}
+
+/**
+// reset(): drop history and EMA state
+**/
+void DS18B20_Filter::reset() {
+  _ema = 0;
+  _count = 0;
+  _head = 0;
+  _rejects = 0;
+}
+
+/**
+// apply(): spike rejector -> median -> EMA
+**/
+bool DS18B20_Filter::apply(int16_t &raw) {
+  if (_mode == DS18B20_FILTER_NONE) return true;
+
+  if ((_mode & DS18B20_FILTER_SPIKE) && _count) {
+    int16_t last = _hist[(uint8_t)(_head + DS18B20_FILTER_HISTORY - 1) % DS18B20_FILTER_HISTORY];
+    int32_t delta = (int32_t)raw - last;
+    if (delta < 0) delta = -delta;
+    if (delta > _maxDelta) {
+      if (++_rejects < DS18B20_FILTER_MAX_REJECTS) return false;
+      reset();  // persistent step: accept the new level
+    }
+  }
+  _rejects = 0;
+
+  _hist[_head] = raw;
+  _head = (uint8_t)((_head + 1) % DS18B20_FILTER_HISTORY);
+  if (_count < DS18B20_FILTER_HISTORY) _count++;
+
+  if (_mode & DS18B20_FILTER_MEDIAN5) raw = _median(5);
+  else if (_mode & DS18B20_FILTER_MEDIAN3) raw = _median(3);
+
+  if (_mode & DS18B20_FILTER_EMA) {
+    int32_t sample = (int32_t)raw << 8;
+    if (_count == 1) _ema = sample;  // seed with the first sample
+    else _ema += ((sample - _ema) * _alpha) >> 8;
+    raw = (int16_t)((_ema + 128) >> 8);
+  }
+  return true;
+}
+
+/**
+// _median(): median of the newest n (or fewer, while filling) accepted samples
+**/
+int16_t DS18B20_Filter::_median(uint8_t n) const {
+  if (n > _count) n = _count;
+  int16_t v[DS18B20_FILTER_HISTORY];
+  for (uint8_t i = 0; i < n; i++) {
+    int16_t x = _hist[(uint8_t)(_head + DS18B20_FILTER_HISTORY - 1 - i) % DS18B20_FILTER_HISTORY];
+    uint8_t j = i;
+    for (; j > 0 && v[j - 1] > x; j--) v[j] = v[j - 1];
+    v[j] = x;
+  }
+  return v[n / 2];
+}
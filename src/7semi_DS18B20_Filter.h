@@ -0,0 +1,65 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Filter.h - per-device filter stage on raw temperature values
+//  Written for the 7semi sensor platform
+//
+//  Works on raw int16 readings (1/16 °C) from the poll() sweep, so filtered values cost no extra
+//  conversions. Stages run in this order, each one optional:
+//    spike rejector  - drops a sample that moves more than maxDelta from the last accepted one;
+//                      after DS18B20_FILTER_MAX_REJECTS drops in a row the new level is accepted
+//    median of 3 / 5 - over the last accepted samples
+//    EMA             - exponential moving average, alpha in 1/256 (Q8), state kept in Q8
+//  State is bounded (history of 5 samples) and lives in the driver's device table.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_FILTER_H_
+#define _7SEMI_DS18B20_FILTER_H_
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include "7semi_DS18B20_Host.h"
+#endif
+
+// Filter stage bits for setFilter()
+#define DS18B20_FILTER_NONE 0x00
+#define DS18B20_FILTER_SPIKE 0x01
+#define DS18B20_FILTER_MEDIAN3 0x02
+#define DS18B20_FILTER_MEDIAN5 0x04
+#define DS18B20_FILTER_EMA 0x08
+
+#define DS18B20_FILTER_HISTORY 5
+#define DS18B20_FILTER_MAX_REJECTS 3
+
+class DS18B20_Filter {
+public:
+  DS18B20_Filter();
+
+  // configure(): select stages; alphaQ8 = weight of a new sample in 1/256 (1..255), maxDelta =
+  // largest accepted step between samples in 1/16 °C. Clears the history.
+  void configure(uint8_t mode, uint8_t alphaQ8, uint16_t maxDelta);
+
+  // reset(): clear history and EMA state, keep the configuration.
+  void reset();
+
+  // apply(): run the stages on 'raw' in place. Returns false if the spike rejector dropped it.
+  bool apply(int16_t &raw);
+
+  uint8_t mode() const { return _mode; }
+
+private:
+  int16_t _hist[DS18B20_FILTER_HISTORY];  // accepted samples, ring buffer
+  int32_t _ema;                           // EMA state in Q8
+  uint16_t _maxDelta;
+  uint8_t _mode;
+  uint8_t _alpha;
+  uint8_t _count;    // valid history entries
+  uint8_t _head;     // next history slot
+  uint8_t _rejects;  // consecutive spike rejections
+
+  int16_t _median(uint8_t n) const;
+};
+
+#endif
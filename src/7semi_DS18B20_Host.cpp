@@ -0,0 +1,51 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Host.cpp - POSIX timing for host (non-Arduino) builds
+//  Written for the 7semi sensor platform
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#if !defined(ARDUINO)
+
+#include "7semi_DS18B20_Host.h"
+#include <time.h>
+#include <sched.h>
+
+static uint64_t _hostMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static const uint64_t _hostStart = _hostMicros();
+
+void (*DS18B20_hostPinWrite)(uint8_t pin, uint8_t value) = nullptr;
+
+unsigned long millis() {
+  return (unsigned long)((_hostMicros() - _hostStart) / 1000ULL);
+}
+
+unsigned long micros() {
+  return (unsigned long)(_hostMicros() - _hostStart);
+}
+
+void delay(unsigned long ms) {
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+  nanosleep(&ts, nullptr);
+}
+
+void delayMicroseconds(unsigned int us) {
+  struct timespec ts;
+  ts.tv_sec = us / 1000000;
+  ts.tv_nsec = (long)(us % 1000000) * 1000L;
+  nanosleep(&ts, nullptr);
+}
+
+void yield() {
+  sched_yield();
+}
+
+#endif
@@ -0,0 +1,48 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Host.h - minimal Arduino API subset for host (non-Arduino) builds
+//  Written for the 7semi sensor platform
+//
+//  Used instead of Arduino.h when ARDUINO is not defined, e.g. on Linux gateways running the
+//  UART, DS2482 or sysfs transports. Timing comes from the POSIX monotonic clock; GPIO calls
+//  are no-ops (use strongPullupPin = -1 on hosts). Simulators and benchmarks can observe
+//  digitalWrite() through DS18B20_hostPinWrite.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_HOST_H_
+#define _7SEMI_DS18B20_HOST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef HIGH
+#define HIGH 0x1
+#define LOW 0x0
+#endif
+#ifndef INPUT
+#define INPUT 0x0
+#define OUTPUT 0x1
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// DS18B20_hostPinWrite: optional observer of digitalWrite() calls (nullptr = none).
+extern void (*DS18B20_hostPinWrite)(uint8_t pin, uint8_t value);
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t value) {
+  if (DS18B20_hostPinWrite) DS18B20_hostPinWrite(pin, value);
+}
+inline int digitalRead(uint8_t) {
+  return LOW;
+}
+
+#endif
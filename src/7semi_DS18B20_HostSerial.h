@@ -0,0 +1,99 @@
+/***************************************************************************************************
+//  7semi_DS18B20_HostSerial.h - POSIX serial port for DS18B20_UARTBusT on Linux hosts
+//  Written for the 7semi sensor platform
+//
+//  Raw 8N1 termios port with the Port interface expected by DS18B20_UARTBusT, so a gateway can
+//  drive a USB-UART 1-Wire adapter (or a pty) directly:
+//
+//    DS18B20_HostSerial port("/dev/ttyUSB0");
+//    DS18B20_UARTBusT<DS18B20_HostSerial> uart(port);
+//    DS18B20_Driver<DS18B20_Transport> sensors(uart);
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_HOSTSERIAL_H_
+#define _7SEMI_DS18B20_HOSTSERIAL_H_
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "7semi_DS18B20_Transport.h"
+
+class DS18B20_HostSerial {
+public:
+  // timeoutMs: maximum wait for echo bytes in readBytes()
+  explicit DS18B20_HostSerial(const char *device, int timeoutMs = 100)
+    : _device(device), _fd(-1), _timeoutMs(timeoutMs) {}
+
+  ~DS18B20_HostSerial() {
+    if (_fd >= 0) ::close(_fd);
+  }
+
+  // begin(): open on first use, then switch speed (9600 for reset, 115200 for slots).
+  bool begin(unsigned long baud) {
+    if (_fd < 0) {
+      _fd = ::open(_device, O_RDWR | O_NOCTTY);
+      if (_fd < 0) return false;
+    }
+    struct termios tio;
+    if (tcgetattr(_fd, &tio) != 0) return false;
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    speed_t speed = (baud == 9600) ? B9600 : B115200;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    return tcsetattr(_fd, TCSADRAIN, &tio) == 0;
+  }
+
+  size_t write(const uint8_t *buf, size_t len) {
+    size_t done = 0;
+    while (_fd >= 0 && done < len) {
+      ssize_t n = ::write(_fd, buf + done, len - done);
+      if (n <= 0) break;
+      done += (size_t)n;
+    }
+    return done;
+  }
+
+  size_t readBytes(uint8_t *buf, size_t len) {
+    size_t done = 0;
+    while (_fd >= 0 && done < len) {
+      struct pollfd p = { _fd, POLLIN, 0 };
+      if (::poll(&p, 1, _timeoutMs) <= 0) break;
+      ssize_t n = ::read(_fd, buf + done, len - done);
+      if (n <= 0) break;
+      done += (size_t)n;
+    }
+    return done;
+  }
+
+  int available() {
+    struct pollfd p = { _fd, POLLIN, 0 };
+    return (_fd >= 0 && ::poll(&p, 1, 0) > 0) ? 1 : 0;
+  }
+
+  int read() {
+    uint8_t v;
+    return (readBytes(&v, 1) == 1) ? v : -1;
+  }
+
+  void flush() {
+    if (_fd >= 0) tcdrain(_fd);
+  }
+
+private:
+  const char *_device;
+  int _fd;
+  int _timeoutMs;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,92 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Latency.h - log2 latency histograms for driver operations
+//  Written for the 7semi sensor platform
+//
+//  Enabled with #define DS18B20_LATENCY 1 before including 7semi_DS18B20.h (or as a compiler
+//  flag); otherwise nothing is recorded and no RAM is used. Bucket i counts durations with a
+//  bit length of i microseconds, i.e. [2^(i-1), 2^i) us, bucket 0 = 0 us, the last bucket
+//  collects everything above ~1 s (a 12-bit conversion still lands in its own bucket). Counters
+//  saturate at 65535.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_LATENCY_H_
+#define _7SEMI_DS18B20_LATENCY_H_
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include "7semi_DS18B20_Host.h"
+#endif
+
+#ifndef DS18B20_LATENCY
+#define DS18B20_LATENCY 0
+#endif
+
+#define DS18B20_LATENCY_BUCKETS 22
+
+// Measured operations
+#define DS18B20_LAT_READ_TEMPERATURE 0
+#define DS18B20_LAT_READ_SCRATCHPAD 1
+#define DS18B20_LAT_SEARCH 2
+#define DS18B20_LAT_COPY_SCRATCHPAD 3
+#define DS18B20_LAT_COUNT 4
+
+// DS18B20_Histogram: exportable latency histogram of one operation (48 bytes).
+struct DS18B20_Histogram {
+  uint16_t bucket[DS18B20_LATENCY_BUCKETS];
+  uint32_t maxUs;
+
+  // record(): add one duration.
+  void record(uint32_t us) {
+    uint8_t b = 0;
+    for (uint32_t v = us; v && b < DS18B20_LATENCY_BUCKETS - 1; v >>= 1) b++;
+    if (bucket[b] != 0xFFFF) bucket[b]++;
+    if (us > maxUs) maxUs = us;
+  }
+
+  // count(): number of recorded durations.
+  uint32_t count() const {
+    uint32_t n = 0;
+    for (uint8_t i = 0; i < DS18B20_LATENCY_BUCKETS; i++) n += bucket[i];
+    return n;
+  }
+
+  // percentileUs(): upper bound in us of the bucket holding the given percentile (e.g. 50, 99),
+  // limited to the largest recorded duration.
+  uint32_t percentileUs(uint8_t percent) const {
+    uint32_t n = count();
+    if (n == 0) return 0;
+    uint32_t rank = (n * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < DS18B20_LATENCY_BUCKETS; i++) {
+      seen += bucket[i];
+      if (seen < rank) continue;
+      uint32_t upper = (1UL << i) - 1;
+      return (i == DS18B20_LATENCY_BUCKETS - 1 || upper > maxUs) ? maxUs : upper;
+    }
+    return maxUs;
+  }
+};
+
+#if DS18B20_LATENCY
+// DS18B20_LatencyScope: records the lifetime of the scope into a histogram.
+class DS18B20_LatencyScope {
+public:
+  explicit DS18B20_LatencyScope(DS18B20_Histogram &h)
+    : _h(h), _start(micros()) {}
+  ~DS18B20_LatencyScope() { _h.record((uint32_t)(micros() - _start)); }
+
+private:
+  DS18B20_Histogram &_h;
+  uint32_t _start;
+};
+
+#define DS18B20_MEASURE(op) DS18B20_LatencyScope _latencyScope(_latency[op])
+#else
+#define DS18B20_MEASURE(op)
+#endif
+
+#endif
@@ -0,0 +1,402 @@
+/***************************************************************************************************
+//  7semi_DS18B20_LinuxW1.cpp - Linux w1 subsystem (sysfs) transport implementation
+//  Written for the 7semi sensor platform
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "7semi_DS18B20_LinuxW1.h"
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+// Constructor: remember sysfs root; slaves are scanned on first use
+**/
+DS18B20_LinuxW1Bus::DS18B20_LinuxW1Bus(const char *sysfsRoot)
+  : _count(0), _masters(0), _scanned(false), _state(W1_IDLE), _selected(-1), _bitCount(0), _shift(0), _len(0), _pos(0), _powerBit(1), _searchIndex(0), _searchBit(0), _participants(0) {
+  snprintf(_root, sizeof(_root), "%.*s", (int)sizeof(_root) - 1, sysfsRoot);
+}
+
+DS18B20_LinuxW1Bus::~DS18B20_LinuxW1Bus() {
+  _closeAll();
+}
+
+/**
+// scan(): list 28-* slaves (ROM rebuilt from the name) and bus masters, pre-open w1_slave files
+**/
+uint8_t DS18B20_LinuxW1Bus::scan() {
+  _closeAll();
+  _scanned = true;
+  DIR *dir = opendir(_root);
+  if (!dir) return 0;
+  struct dirent *e;
+  while ((e = readdir(dir)) != nullptr) {
+    if (strncmp(e->d_name, "w1_bus_master", 13) == 0 && _masters < DS18B20_LINUXW1_MAX_MASTERS) {
+      snprintf(_master[_masters++], sizeof(_master[0]), "%.*s", (int)sizeof(_master[0]) - 1, e->d_name);
+      continue;
+    }
+    if (strncmp(e->d_name, "28-", 3) != 0 || strlen(e->d_name) != 15) continue;
+    if (_count >= DS18B20_LINUXW1_MAX_DEVICES) continue;
+
+    // name holds serial bytes 6..1 as hex, most significant first
+    uint8_t *rom = _rom[_count];
+    rom[0] = 0x28;
+    bool ok = true;
+    for (uint8_t i = 0; i < 6 && ok; i++) {
+      char hex[3] = { e->d_name[3 + i * 2], e->d_name[4 + i * 2], 0 };
+      char *end;
+      rom[6 - i] = (uint8_t)strtoul(hex, &end, 16);
+      ok = (*end == 0);
+    }
+    if (!ok) continue;
+    rom[7] = 0;
+    for (uint8_t i = 0; i < 7; i++) {
+      uint8_t b = rom[i];
+      for (uint8_t j = 0; j < 8; j++) {
+        uint8_t mix = (rom[7] ^ b) & 0x01;
+        rom[7] >>= 1;
+        if (mix) rom[7] ^= 0x8C;
+        b >>= 1;
+      }
+    }
+
+    snprintf(_name[_count], sizeof(_name[0]), "%.15s", e->d_name);
+    char path[DS18B20_LINUXW1_PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/%s/w1_slave", _root, _name[_count]);
+    _slaveFd[_count] = open(path, O_RDONLY);
+    _count++;
+  }
+  closedir(dir);
+  return _count;
+}
+
+/**
+// reset(): start a new command sequence; presence if any slave is listed
+**/
+uint8_t DS18B20_LinuxW1Bus::reset() {
+  if (!_scanned) scan();
+  _state = W1_ROM_CMD;
+  _selected = -1;
+  _bitCount = 0;
+  _shift = 0;
+  _len = 0;
+  return _count ? 1 : 0;
+}
+
+/**
+// writeBit(): assemble bytes from single write slots
+**/
+void DS18B20_LinuxW1Bus::writeBit(uint8_t v) {
+  _shift |= (uint8_t)((v ? 1 : 0) << _bitCount);
+  if (++_bitCount < 8) return;
+  uint8_t b = _shift;
+  _bitCount = 0;
+  _shift = 0;
+  _byte(b);
+}
+
+/**
+// readBit(): next scratchpad/ROM bit, power supply answer, or 1 (idle / operation complete)
+**/
+uint8_t DS18B20_LinuxW1Bus::readBit() {
+  if (_state == W1_POWER) return _powerBit;
+  if (_state != W1_TX || _pos >= _len * 8) return 1;
+  uint8_t bit = (_buf[_pos >> 3] >> (_pos & 0x07)) & 0x01;
+  _pos++;
+  return bit;
+}
+
+/**
+// write(): whole bytes skip the bit assembler
+**/
+void DS18B20_LinuxW1Bus::write(uint8_t v, uint8_t power) {
+  (void)power;  // the kernel master handles strong pull-up itself
+  _byte(v);
+}
+
+/**
+// resetSearch(): rescan sysfs so hot-plugged sensors show up in the next enumeration
+**/
+void DS18B20_LinuxW1Bus::resetSearch() {
+  DS18B20_Transport::resetSearch();
+  _searchIndex = 0;
+  if (_scanned) scan();
+}
+
+/**
+// search(): enumerate listed slaves; Alarm Search filters on the latched scratchpad
+**/
+bool DS18B20_LinuxW1Bus::search(uint8_t rom[8], bool alarmOnly) {
+  if (!_scanned) scan();
+  _state = W1_IDLE;
+  while (_searchIndex < _count) {
+    uint8_t i = _searchIndex++;
+    if (alarmOnly && !_inAlarm(i)) continue;
+    memcpy(rom, _rom[i], 8);
+    return true;
+  }
+  return false;
+}
+
+/**
+// execute(): decode the script byte-wise; READ steps copy the decoder's reply buffer directly
+**/
+bool DS18B20_LinuxW1Bus::execute(const DS18B20_Script &script, uint8_t *rx) {
+  if (!script.valid()) return false;
+  const uint8_t *p = script.data();
+  const uint8_t *end = p + script.length();
+  while (p < end) {
+    uint8_t op = *p++;
+    uint8_t n = 0;
+    switch (op) {
+      case DS18B20_OP_RESET:
+        if (!reset()) return false;
+        break;
+      case DS18B20_OP_MATCH:
+        _byte(0x55);
+        for (uint8_t i = 0; i < 8; i++) _byte(p[i]);
+        p += 8;
+        if (_state != W1_FUNC_CMD) return false;  // no slave directory: the device is not on the bus
+        break;
+      case DS18B20_OP_SKIP:
+        _byte(0xCC);
+        break;
+      case DS18B20_OP_WRITE:
+        n = *p++;
+        for (uint8_t i = 0; i < n; i++) _byte(p[i]);
+        p += n;
+        break;
+      case DS18B20_OP_READ:
+        n = *p++;
+        for (uint8_t i = 0; i < n; i++) {
+          if (_state == W1_TX && (_pos >> 3) < _len) {
+            *rx++ = _buf[_pos >> 3];
+            _pos += 8;
+          } else {
+            *rx++ = (_state == W1_POWER && !_powerBit) ? 0x00 : 0xFF;
+          }
+        }
+        break;
+      case DS18B20_OP_READ_CHECKED: {
+        // one pread() already fetched all 9 bytes; only the verdict is left to add
+        for (uint8_t i = 0; i < 9; i++) {
+          bool avail = (_state == W1_TX && (_pos >> 3) < _len);
+          rx[i] = avail ? _buf[_pos >> 3] : 0xFF;
+          if (avail) _pos += 8;
+        }
+        DS18B20_Script::checkRead(rx);
+        rx += 10;
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+/**
+// _closeAll(): release pre-opened w1_slave descriptors
+**/
+void DS18B20_LinuxW1Bus::_closeAll() {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_slaveFd[i] >= 0) close(_slaveFd[i]);
+  }
+  _count = 0;
+  _masters = 0;
+}
+
+/**
+// triplet(): answer one Search ROM bit from the listed slaves' ROMs
+**/
+uint8_t DS18B20_LinuxW1Bus::triplet(uint8_t direction) {
+  if (_state != W1_SEARCH || _searchBit >= 64) return 0x03;
+  bool has0 = false;
+  bool has1 = false;
+  for (uint8_t i = 0; i < _count && i < 64; i++) {
+    if (!(_participants & ((uint64_t)1 << i))) continue;
+    if ((_rom[i][_searchBit >> 3] >> (_searchBit & 0x07)) & 0x01) has1 = true;
+    else has0 = true;
+  }
+  if (!has0 && !has1) return 0x03;
+  uint8_t idBit = has0 ? 0 : 1;
+  uint8_t cmpBit = has1 ? 0 : 1;
+  if (idBit != cmpBit) direction = idBit;
+  for (uint8_t i = 0; i < _count && i < 64; i++) {
+    if (((_rom[i][_searchBit >> 3] >> (_searchBit & 0x07)) & 0x01) != direction) _participants &= ~((uint64_t)1 << i);
+  }
+  _searchBit++;
+  return (uint8_t)(idBit | (cmpBit << 1) | (direction << 2));
+}
+
+/**
+// _byte(): ROM / function command decoder
+**/
+void DS18B20_LinuxW1Bus::_byte(uint8_t b) {
+  switch (_state) {
+    case W1_ROM_CMD:
+      if (b == 0x55) {  // Match ROM
+        _state = W1_MATCH;
+        _len = 0;
+      } else if (b == 0xCC) {  // Skip ROM
+        _selected = -1;
+        _state = W1_FUNC_CMD;
+      } else if (b == 0xF0) {  // Search ROM, bit by bit through triplet()
+        _searchBit = 0;
+        _participants = 0;
+        for (uint8_t i = 0; i < _count && i < 64; i++) _participants |= (uint64_t)1 << i;
+        _state = W1_SEARCH;
+      } else if (b == 0x33 && _count == 1) {  // Read ROM
+        memcpy(_buf, _rom[0], 8);
+        _len = 8;
+        _pos = 0;
+        _state = W1_TX;
+      } else {
+        _state = W1_IDLE;
+      }
+      break;
+    case W1_MATCH:
+      _buf[_len++] = b;
+      if (_len < 8) break;
+      _state = W1_IDLE;
+      for (uint8_t i = 0; i < _count; i++) {
+        if (memcmp(_rom[i], _buf, 8) == 0) {
+          _selected = i;
+          _state = W1_FUNC_CMD;
+          break;
+        }
+      }
+      break;
+    case W1_FUNC_CMD:
+      _function(b);
+      break;
+    case W1_RX: {
+      _buf[_len++] = b;
+      if (_len < 3) break;
+      // TH, TL, config -> alarms ("TL TH") and resolution
+      char alarms[16];
+      char res[4];
+      snprintf(alarms, sizeof(alarms), "%d %d", (int8_t)_buf[1], (int8_t)_buf[0]);
+      snprintf(res, sizeof(res), "%d", 9 + ((_buf[2] >> 5) & 0x03));
+      for (uint8_t i = 0; i < _count; i++) {
+        if (_selected >= 0 && i != _selected) continue;
+        _writeAttr(_name[i], "alarms", alarms);
+        _writeAttr(_name[i], "resolution", res);
+      }
+      _state = W1_IDLE;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+/**
+// _function(): map DS18B20 function commands to sysfs attributes
+**/
+void DS18B20_LinuxW1Bus::_function(uint8_t cmd) {
+  _state = W1_IDLE;  // read slots return 1 = operation complete
+  switch (cmd) {
+    case 0x44:  // Convert T: bulk conversion for Skip ROM; w1_slave converts on read otherwise
+      if (_selected < 0) {
+        for (uint8_t m = 0; m < _masters; m++) _writeAttr(_master[m], "therm_bulk_read", "trigger");
+      }
+      break;
+    case 0xBE:  // Read Scratchpad
+      if (_selected < 0 && _count != 1) break;
+      _readScratchpad(_selected < 0 ? 0 : (uint8_t)_selected, _buf);
+      _len = 9;
+      _pos = 0;
+      _state = W1_TX;
+      break;
+    case 0x4E:  // Write Scratchpad
+      _len = 0;
+      _state = W1_RX;
+      break;
+    case 0x48:  // Copy Scratchpad
+    case 0xB8:  // Recall E2
+      for (uint8_t i = 0; i < _count; i++) {
+        if (_selected >= 0 && i != _selected) continue;
+        _writeAttr(_name[i], "eeprom_cmd", cmd == 0x48 ? "save" : "restore");
+      }
+      break;
+    case 0xB4:  // Read Power Supply: any parasite device pulls the slot low
+      _powerBit = 1;
+      for (uint8_t i = 0; i < _count; i++) {
+        if (_selected >= 0 && i != _selected) continue;
+        if (_readAttrInt(_name[i], "ext_power", 1) == 0) _powerBit = 0;
+      }
+      _state = W1_POWER;
+      break;
+  }
+}
+
+/**
+// _readScratchpad(): pread() of w1_slave at offset 0 (no reopen); first line holds 9 hex bytes
+**/
+bool DS18B20_LinuxW1Bus::_readScratchpad(uint8_t index, uint8_t sp[9]) {
+  memset(sp, 0xFF, 9);  // unreadable device looks like an open bus
+  if (_slaveFd[index] < 0) return false;
+  char text[128];
+  ssize_t n = pread(_slaveFd[index], text, sizeof(text) - 1, 0);
+  if (n <= 0) return false;
+  text[n] = 0;
+  char *p = text;
+  for (uint8_t i = 0; i < 9; i++) {
+    char *end;
+    unsigned long v = strtoul(p, &end, 16);
+    if (end == p) return false;
+    sp[i] = (uint8_t)v;
+    p = end;
+  }
+  return true;
+}
+
+/**
+// _inAlarm(): latched temperature outside TH/TL (same rule as the device's alarm flag)
+**/
+bool DS18B20_LinuxW1Bus::_inAlarm(uint8_t index) {
+  uint8_t sp[9];
+  if (!_readScratchpad(index, sp)) return false;
+  int8_t t = (int8_t)((int16_t)((sp[1] << 8) | sp[0]) >> 4);
+  return t >= (int8_t)sp[2] || t <= (int8_t)sp[3];
+}
+
+/**
+// _writeAttr(): write a value to <root>/<dir>/<attr>
+**/
+bool DS18B20_LinuxW1Bus::_writeAttr(const char *dir, const char *attr, const char *value) {
+  char path[DS18B20_LINUXW1_PATH_MAX + 48];
+  snprintf(path, sizeof(path), "%s/%s/%s", _root, dir, attr);
+  int fd = open(path, O_WRONLY);
+  if (fd < 0) return false;
+  size_t len = strlen(value);
+  bool ok = ::write(fd, value, len) == (ssize_t)len;
+  close(fd);
+  return ok;
+}
+
+/**
+// _readAttrInt(): read an integer attribute, 'fallback' if missing
+**/
+int DS18B20_LinuxW1Bus::_readAttrInt(const char *dir, const char *attr, int fallback) {
+  char path[DS18B20_LINUXW1_PATH_MAX + 48];
+  snprintf(path, sizeof(path), "%s/%s/%s", _root, dir, attr);
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return fallback;
+  char text[16];
+  ssize_t n = ::read(fd, text, sizeof(text) - 1);
+  close(fd);
+  if (n <= 0) return fallback;
+  text[n] = 0;
+  return atoi(text);
+}
+
+#endif
@@ -0,0 +1,103 @@
+/***************************************************************************************************
+//  7semi_DS18B20_LinuxW1.h - Linux w1 subsystem (sysfs) transport
+//  Written for the 7semi sensor platform
+//
+//  Lets DS18B20_Driver run on gateways using the kernel w1-gpio / w1_therm drivers. The kernel
+//  owns the bus timing, so this transport decodes the driver's command stream and maps it to
+//  sysfs attributes of /sys/bus/w1/devices/28-*:
+//
+//    Search ROM            -> directory listing of 28-* slaves (triplets emulated on the listing,
+//                             e.g. for verifyPresence())
+//    Skip ROM + Convert T  -> "trigger" to every master's therm_bulk_read
+//    Read Scratchpad       -> pread() of the pre-opened w1_slave file (9 bytes + kernel CRC check)
+//    Write Scratchpad      -> alarms ("TL TH") and resolution
+//    Copy Scratchpad / Recall E2 -> eeprom_cmd "save" / "restore"
+//    Read Power Supply     -> ext_power
+//
+//  execute() feeds a transaction script straight into the decoder, so a driver operation costs
+//  one sysfs access (e.g. one pread() for Read Scratchpad) and no per-bit calls. A Match ROM
+//  for a ROM without slave directory fails the script like a missing presence pulse.
+//
+//  The sysfs root is configurable, so a fake tree in a temporary directory works as a stand-in.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_LINUXW1_H_
+#define _7SEMI_DS18B20_LINUXW1_H_
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "7semi_DS18B20_Transport.h"
+
+#ifndef DS18B20_LINUXW1_MAX_DEVICES
+#define DS18B20_LINUXW1_MAX_DEVICES 64
+#endif
+#define DS18B20_LINUXW1_MAX_MASTERS 4
+#define DS18B20_LINUXW1_PATH_MAX 160
+
+class DS18B20_LinuxW1Bus : public DS18B20_Transport {
+public:
+  explicit DS18B20_LinuxW1Bus(const char *sysfsRoot = "/sys/bus/w1/devices");
+  ~DS18B20_LinuxW1Bus();
+
+  // scan(): (re)list 28-* slaves and w1_bus_master* entries; pre-opens each w1_slave.
+  // Returns the number of slaves. Called by resetSearch() and the first reset().
+  uint8_t scan();
+
+  uint8_t reset() override;
+  void writeBit(uint8_t v) override;
+  uint8_t readBit() override;
+  void write(uint8_t v, uint8_t power = 0) override;
+  void resetSearch() override;
+  bool search(uint8_t rom[8], bool alarmOnly = false) override;
+  uint8_t triplet(uint8_t direction) override;
+  bool execute(const DS18B20_Script &script, uint8_t *rx) override;
+
+private:
+  enum {
+    W1_IDLE,
+    W1_ROM_CMD,
+    W1_MATCH,
+    W1_FUNC_CMD,
+    W1_TX,
+    W1_RX,
+    W1_POWER,
+    W1_SEARCH
+  };
+
+  char _root[DS18B20_LINUXW1_PATH_MAX];
+  char _name[DS18B20_LINUXW1_MAX_DEVICES][16];  // "28-0123456789ab"
+  uint8_t _rom[DS18B20_LINUXW1_MAX_DEVICES][8];
+  int _slaveFd[DS18B20_LINUXW1_MAX_DEVICES];  // pre-opened w1_slave
+  uint8_t _count;
+  char _master[DS18B20_LINUXW1_MAX_MASTERS][24];
+  uint8_t _masters;
+  bool _scanned;
+
+  // command decoder state
+  uint8_t _state;
+  int16_t _selected;  // device index, -1 = Skip ROM (all)
+  uint8_t _bitCount;
+  uint8_t _shift;
+  uint8_t _buf[9];
+  uint8_t _len;
+  uint8_t _pos;  // next bit to send from _buf
+  uint8_t _powerBit;
+  uint8_t _searchIndex;
+  uint8_t _searchBit;       // next ROM bit of a triplet search
+  uint64_t _participants;  // listed slaves still matching the triplet search
+
+  void _closeAll();
+  void _byte(uint8_t b);
+  void _function(uint8_t cmd);
+  bool _readScratchpad(uint8_t index, uint8_t sp[9]);
+  bool _inAlarm(uint8_t index);
+  bool _writeAttr(const char *dir, const char *attr, const char *value);
+  int _readAttrInt(const char *dir, const char *attr, int fallback);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,229 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Script.h - byte-script description of a 1-Wire transaction
+//  Written for the 7semi sensor platform
+//
+//  A script is a fixed-size list of reset / Match ROM / Skip ROM / write / read-N steps.
+//  The driver builds one per operation and hands it to the transport's execute() in one call;
+//  bit-level transports run it step by step (run()), while queuing or protocol-translating
+//  transports (UART, Linux w1) can execute the whole transaction with a single I/O call.
+//  Scripts never wait: Convert T and Copy Scratchpad end the script, and the driver times them
+//  with a deadline (strong pull-up included) so poll() and the caller keep running.
+//
+//  Encoding: [op] [args...] ... ; consecutive write() calls are merged into one WRITE step.
+//    RESET                      reset, abort script if no presence pulse
+//    MATCH  rom[8]              Match ROM
+//    SKIP                       Skip ROM
+//    WRITE  n data[n]           write n bytes
+//    READ   n                   read n bytes into the rx buffer
+//    READ_CHECKED               scratchpad read: 9 bytes plus a DS18B20_CHECK_* verdict byte
+//
+//  READ_CHECKED updates the CRC as each byte comes off the wire and gives up with a reset once
+//  the scratchpad cannot be valid: a configuration byte other than 0 R1 R0 1 1 1 1 1 (includes an
+//  all-0xFF / all-0x00 read of a dead device or stuck bus) or reserved byte 5 not 0xFF. The
+//  unread bytes repeat the last byte read, so stuck-bus patterns still classify as such.
+//  Stopping early is the transport's choice: run() reads the scratchpad in chunks through the
+//  bus, while transports that fetch all 9 bytes in one transfer (UART, Linux w1) read them in
+//  one piece and apply the same verdict with checkRead().
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_SCRIPT_H_
+#define _7SEMI_DS18B20_SCRIPT_H_
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include "7semi_DS18B20_Host.h"
+#endif
+
+// script bytes; Write Scratchpad + read-back (two resets, two Match ROMs) needs 30
+#ifndef DS18B20_SCRIPT_SIZE
+#define DS18B20_SCRIPT_SIZE 32
+#endif
+
+#define DS18B20_OP_RESET 0x01
+#define DS18B20_OP_MATCH 0x02
+#define DS18B20_OP_SKIP 0x03
+#define DS18B20_OP_WRITE 0x04
+#define DS18B20_OP_READ 0x06
+#define DS18B20_OP_READ_CHECKED 0x08
+
+// READ_CHECKED verdicts (byte 9 of its rx bytes)
+#define DS18B20_CHECK_OK 0
+#define DS18B20_CHECK_CRC 1      // all 9 bytes read, CRC mismatch
+#define DS18B20_CHECK_ABORTED 2  // invalid pattern, read stopped early
+
+class DS18B20_Script {
+public:
+  DS18B20_Script()
+    : _len(0), _rxLen(0), _lastWrite(0xFF), _ok(true) {}
+
+  DS18B20_Script &reset() { return _op(DS18B20_OP_RESET, 0); }
+  DS18B20_Script &skip() { return _op(DS18B20_OP_SKIP, 0); }
+
+  DS18B20_Script &match(const uint8_t rom[8]) {
+    if (_op(DS18B20_OP_MATCH, 8)._ok) {
+      memcpy(&_buf[_len], rom, 8);
+      _len += 8;
+    }
+    return *this;
+  }
+
+  DS18B20_Script &write(uint8_t v) {
+    if (_lastWrite != 0xFF && _len < DS18B20_SCRIPT_SIZE) {
+      _buf[_lastWrite]++;  // extend the previous WRITE step
+    } else {
+      if (!_op(DS18B20_OP_WRITE, 2)._ok) return *this;
+      _lastWrite = _len;
+      _buf[_len++] = 1;
+    }
+    if (_len >= DS18B20_SCRIPT_SIZE) return _fail();
+    _buf[_len++] = v;
+    return *this;
+  }
+
+  DS18B20_Script &write(const uint8_t *data, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) write(data[i]);
+    return *this;
+  }
+
+  DS18B20_Script &read(uint8_t n) {
+    if (_op(DS18B20_OP_READ, 1)._ok) {
+      _buf[_len++] = n;
+      _rxLen += n;
+    }
+    return *this;
+  }
+
+  // readChecked(): streaming scratchpad read, stores 10 bytes (see READ_CHECKED)
+  DS18B20_Script &readChecked() {
+    if (_op(DS18B20_OP_READ_CHECKED, 0)._ok) _rxLen += 10;
+    return *this;
+  }
+
+  // valid(): false if a step did not fit into DS18B20_SCRIPT_SIZE.
+  bool valid() const { return _ok; }
+  const uint8_t *data() const { return _buf; }
+  uint8_t length() const { return _len; }
+
+  // rxLength(): total bytes the READ steps store into the rx buffer.
+  uint8_t rxLength() const { return _rxLen; }
+
+  // run(): step-by-step interpreter on any Bus (the default execute()). Returns false if the
+  // script is invalid or a RESET saw no presence pulse; queued slots are flushed at the end.
+  template <class Bus>
+  static bool run(Bus &bus, const DS18B20_Script &script, uint8_t *rx) {
+    if (!script._ok) return false;
+    const uint8_t *p = script._buf;
+    const uint8_t *end = p + script._len;
+    while (p < end) {
+      switch (*p++) {
+        case DS18B20_OP_RESET:
+          if (!bus.reset()) return false;
+          break;
+        case DS18B20_OP_MATCH:
+          bus.select(p);
+          p += 8;
+          break;
+        case DS18B20_OP_SKIP:
+          bus.skip();
+          break;
+        case DS18B20_OP_WRITE:
+          bus.writeBytes(p + 1, p[0]);
+          p += 1 + p[0];
+          break;
+        case DS18B20_OP_READ:
+          bus.readBytes(rx, p[0]);
+          rx += p[0];
+          p++;
+          break;
+        case DS18B20_OP_READ_CHECKED:
+          _readChecked(bus, rx);
+          rx += 10;
+          break;
+        default:
+          return false;
+      }
+    }
+    bus.flush();
+    return true;
+  }
+
+  // checkRead(): READ_CHECKED verdict for 9 bytes read in one piece; stores rx[9] and, if the
+  // pattern is invalid, overwrites the bytes after it exactly as an early abort would.
+  static void checkRead(uint8_t *rx) {
+    uint8_t crc = 0;
+    for (uint8_t pos = 0; pos < 9;) {
+      crc = crcUpdate(crc, rx[pos++]);
+      if (_invalidAt(rx, pos)) {
+        _abort(rx, pos);
+        return;
+      }
+    }
+    rx[9] = (crc == 0) ? DS18B20_CHECK_OK : DS18B20_CHECK_CRC;  // CRC over all 9 bytes leaves 0
+  }
+
+  // crcUpdate(): one byte of the 1-Wire CRC8 (X^8 + X^5 + X^4 + 1)
+  static uint8_t crcUpdate(uint8_t crc, uint8_t b) {
+    for (uint8_t i = 0; i < 8; i++) {
+      uint8_t mix = (crc ^ b) & 0x01;
+      crc >>= 1;
+      if (mix) crc ^= 0x8C;
+      b >>= 1;
+    }
+    return crc;
+  }
+
+private:
+  uint8_t _buf[DS18B20_SCRIPT_SIZE];
+  uint8_t _len;
+  uint8_t _rxLen;
+  uint8_t _lastWrite;  // index of the open WRITE step's count byte, 0xFF if none
+  bool _ok;
+
+  // _op(): append opcode if it and 'args' argument bytes fit
+  DS18B20_Script &_op(uint8_t op, uint8_t args) {
+    _lastWrite = 0xFF;
+    if (!_ok || _len + 1 + args > DS18B20_SCRIPT_SIZE) return _fail();
+    _buf[_len++] = op;
+    return *this;
+  }
+
+  // _readChecked(): bytes 0..4, byte 5, bytes 6..8, each chunk checked before the next is read
+  template <class Bus>
+  static void _readChecked(Bus &bus, uint8_t *rx) {
+    static const uint8_t chunk[3] = { 5, 1, 3 };
+    uint8_t crc = 0;
+    uint8_t pos = 0;
+    for (uint8_t c = 0; c < 3; c++) {
+      bus.readBytes(&rx[pos], chunk[c]);
+      for (uint8_t i = 0; i < chunk[c]; i++) crc = crcUpdate(crc, rx[pos++]);
+      if (_invalidAt(rx, pos)) {
+        bus.reset();  // end the read slots now
+        _abort(rx, pos);
+        return;
+      }
+    }
+    rx[9] = (crc == 0) ? DS18B20_CHECK_OK : DS18B20_CHECK_CRC;
+  }
+
+  // _invalidAt(): the first 'pos' bytes already rule out a valid scratchpad
+  static bool _invalidAt(const uint8_t *rx, uint8_t pos) {
+    return (pos == 5 && (rx[4] & 0x9F) != 0x1F) || (pos == 6 && rx[5] != 0xFF);
+  }
+
+  // _abort(): unread bytes repeat the last byte read
+  static void _abort(uint8_t *rx, uint8_t pos) {
+    for (; pos < 9; pos++) rx[pos] = rx[pos - 1];
+    rx[9] = DS18B20_CHECK_ABORTED;
+  }
+
+  DS18B20_Script &_fail() {
+    _ok = false;
+    return *this;
+  }
+};
+
+#endif
@@ -0,0 +1,281 @@
+/***************************************************************************************************
+//  7semi_DS18B20_SimBus.h - simulated 1-Wire bus with DS18B20 device models
+//  Written for the 7semi sensor platform
+//
+//  Bit-level model of up to DS18B20_SIM_MAX_DEVICES DS18B20 sensors behind a DS18B20_Transport.
+//  Implements ROM commands (Read/Match/Skip ROM, Search, Alarm Search), scratchpad, EEPROM,
+//  conversion and power supply commands with wired-AND read slots, so the driver can run on a
+//  host or without hardware. Conversions complete instantly.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_SIMBUS_H_
+#define _7SEMI_DS18B20_SIMBUS_H_
+
+#include "7semi_DS18B20_Transport.h"
+
+#ifndef DS18B20_SIM_MAX_DEVICES
+#define DS18B20_SIM_MAX_DEVICES 8
+#endif
+
+// DS18B20_SimDevice: state of one simulated sensor
+struct DS18B20_SimDevice {
+  uint8_t rom[8];
+  uint8_t scratchpad[9];
+  uint8_t eeprom[3];  // TH, TL, config
+  int16_t tempRaw;    // 12-bit raw value latched by the next Convert T
+  bool parasite;
+  bool connected;
+
+  // protocol state
+  uint8_t state;
+  uint8_t bitCount;
+  uint8_t shift;
+  uint8_t byteIndex;
+  uint8_t searchPhase;
+};
+
+class DS18B20_SimBus : public DS18B20_Transport {
+public:
+  DS18B20_SimBus()
+    : resets(0), slots(0), _count(0) {}
+
+  // addDevice(): add a sensor with serial number 'serial' (48 bit); returns its index or -1.
+  int8_t addDevice(uint64_t serial, bool parasite = false) {
+    if (_count >= DS18B20_SIM_MAX_DEVICES) return -1;
+    DS18B20_SimDevice &d = _dev[_count];
+    d.rom[0] = 0x28;
+    for (uint8_t i = 1; i < 7; i++) {
+      d.rom[i] = (uint8_t)serial;
+      serial >>= 8;
+    }
+    d.rom[7] = _crc(d.rom, 7);
+    d.eeprom[0] = 75;    // TH power-on default
+    d.eeprom[1] = 70;    // TL power-on default
+    d.eeprom[2] = 0x7F;  // 12-bit
+    d.tempRaw = 0x0190;  // 25 °C
+    d.parasite = parasite;
+    d.connected = true;
+    powerOnReset(_count);
+    return (int8_t)_count++;
+  }
+
+  // powerOnReset(): scratchpad back to 85 °C and EEPROM contents (as after a brown-out).
+  void powerOnReset(uint8_t index) {
+    DS18B20_SimDevice &d = _dev[index];
+    d.scratchpad[0] = 0x50;
+    d.scratchpad[1] = 0x05;
+    memcpy(&d.scratchpad[2], d.eeprom, 3);
+    d.scratchpad[5] = 0xFF;
+    d.scratchpad[6] = 0x0C;
+    d.scratchpad[7] = 0x10;
+    d.scratchpad[8] = _crc(d.scratchpad, 8);
+    d.state = SIM_IDLE;
+  }
+
+  // setTemperature(): temperature (°C) latched by the next conversion.
+  void setTemperature(uint8_t index, float celsius) {
+    _dev[index].tempRaw = (int16_t)(celsius * 16.0f);
+  }
+
+  // setConnected(): simulate an unplugged sensor (no presence, no response).
+  void setConnected(uint8_t index, bool connected) {
+    _dev[index].connected = connected;
+  }
+
+  DS18B20_SimDevice &device(uint8_t index) { return _dev[index]; }
+  uint8_t deviceCount() const { return _count; }
+
+  uint8_t reset() override {
+    resets++;
+    uint8_t presence = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (!_dev[i].connected) continue;
+      _enter(_dev[i], SIM_ROM_CMD);
+      presence = 1;
+    }
+    return presence;
+  }
+
+  void writeBit(uint8_t v) override {
+    slots++;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (_dev[i].connected) _slot(_dev[i], v ? 1 : 0, false);
+    }
+  }
+
+  uint8_t readBit() override {
+    slots++;
+    uint8_t line = 1;  // wired-AND: any device driving 0 wins
+    for (uint8_t i = 0; i < _count; i++) {
+      if (_dev[i].connected) line &= _slot(_dev[i], 1, true);
+    }
+    return line;
+  }
+
+  uint32_t resets;  // reset pulses issued
+  uint32_t slots;   // read/write time slots issued
+
+private:
+  enum {
+    SIM_IDLE,      // waiting for reset
+    SIM_ROM_CMD,   // receiving ROM command
+    SIM_MATCH,     // receiving 64-bit ROM for Match ROM
+    SIM_SEARCH,    // Search ROM / Alarm Search triplets
+    SIM_FUNC_CMD,  // receiving function command
+    SIM_TX,        // sending scratchpad / ROM bytes
+    SIM_RX,        // receiving TH, TL, config
+    SIM_POWER,     // answering Read Power Supply
+    SIM_DONE       // conversion/copy/recall finished, read slots return 1
+  };
+
+  DS18B20_SimDevice _dev[DS18B20_SIM_MAX_DEVICES];
+  uint8_t _count;
+  uint8_t _txBuf[DS18B20_SIM_MAX_DEVICES][9];
+  uint8_t _txLen[DS18B20_SIM_MAX_DEVICES];
+
+  static uint8_t _crc(const uint8_t *data, uint8_t len) {
+    uint8_t crc = 0;
+    while (len--) {
+      uint8_t b = *data++;
+      for (uint8_t i = 0; i < 8; i++) {
+        uint8_t mix = (crc ^ b) & 0x01;
+        crc >>= 1;
+        if (mix) crc ^= 0x8C;
+        b >>= 1;
+      }
+    }
+    return crc;
+  }
+
+  void _enter(DS18B20_SimDevice &d, uint8_t state) {
+    d.state = state;
+    d.bitCount = 0;
+    d.shift = 0;
+    d.byteIndex = 0;
+    d.searchPhase = 0;
+  }
+
+  uint8_t _index(DS18B20_SimDevice &d) { return (uint8_t)(&d - _dev); }
+
+  void _transmit(DS18B20_SimDevice &d, const uint8_t *data, uint8_t len) {
+    memcpy(_txBuf[_index(d)], data, len);
+    _txLen[_index(d)] = len;
+    _enter(d, SIM_TX);
+  }
+
+  bool _inAlarm(const DS18B20_SimDevice &d) {
+    int8_t t = (int8_t)(((int16_t)((d.scratchpad[1] << 8) | d.scratchpad[0])) >> 4);
+    return t >= (int8_t)d.scratchpad[2] || t <= (int8_t)d.scratchpad[3];
+  }
+
+  // _slot(): one time slot for device d; 'in' is the master bit (1 for read slots). Returns the
+  // level the device leaves on the bus (1 = released).
+  uint8_t _slot(DS18B20_SimDevice &d, uint8_t in, bool readSlot) {
+    switch (d.state) {
+      case SIM_ROM_CMD:
+      case SIM_FUNC_CMD:
+      case SIM_MATCH:
+      case SIM_RX:
+        _receive(d, in);
+        return 1;
+      case SIM_SEARCH: {
+        uint8_t bit = (d.rom[d.bitCount >> 3] >> (d.bitCount & 0x07)) & 0x01;
+        if (d.searchPhase == 0) {
+          d.searchPhase = 1;
+          return bit;
+        }
+        if (d.searchPhase == 1) {
+          d.searchPhase = 2;
+          return bit ^ 0x01;
+        }
+        if (in != bit) {
+          d.state = SIM_IDLE;  // lost the search at this bit
+        } else if (++d.bitCount == 64) {
+          d.state = SIM_IDLE;
+        } else {
+          d.searchPhase = 0;
+        }
+        return 1;
+      }
+      case SIM_TX: {
+        uint8_t i = _index(d);
+        if (d.byteIndex >= _txLen[i]) return 1;
+        uint8_t bit = (_txBuf[i][d.byteIndex] >> d.bitCount) & 0x01;
+        if (++d.bitCount == 8) {
+          d.bitCount = 0;
+          d.byteIndex++;
+        }
+        return readSlot ? bit : 1;
+      }
+      case SIM_POWER:
+        return d.parasite ? 0 : 1;
+      default:
+        return 1;
+    }
+  }
+
+  // _receive(): shift in one bit and act on completed bytes
+  void _receive(DS18B20_SimDevice &d, uint8_t in) {
+    d.shift |= (uint8_t)(in << d.bitCount);
+    if (++d.bitCount < 8) return;
+    uint8_t b = d.shift;
+    d.bitCount = 0;
+    d.shift = 0;
+
+    if (d.state == SIM_ROM_CMD) {
+      switch (b) {
+        case 0x33: _transmit(d, d.rom, 8); break;                          // Read ROM
+        case 0x55: _enter(d, SIM_MATCH); break;                            // Match ROM
+        case 0xCC: _enter(d, SIM_FUNC_CMD); break;                         // Skip ROM
+        case 0xF0: _enter(d, SIM_SEARCH); break;                           // Search ROM
+        case 0xEC: _enter(d, _inAlarm(d) ? SIM_SEARCH : SIM_IDLE); break;  // Alarm Search
+        default: d.state = SIM_IDLE; break;
+      }
+    } else if (d.state == SIM_MATCH) {
+      if (b != d.rom[d.byteIndex]) {
+        d.state = SIM_IDLE;
+      } else if (++d.byteIndex == 8) {
+        _enter(d, SIM_FUNC_CMD);
+      }
+    } else if (d.state == SIM_FUNC_CMD) {
+      _function(d, b);
+    } else if (d.state == SIM_RX) {
+      d.scratchpad[2 + d.byteIndex] = (d.byteIndex == 2) ? (uint8_t)((b & 0x60) | 0x1F) : b;
+      d.scratchpad[8] = _crc(d.scratchpad, 8);
+      if (++d.byteIndex == 3) d.state = SIM_IDLE;
+    }
+  }
+
+  void _function(DS18B20_SimDevice &d, uint8_t cmd) {
+    switch (cmd) {
+      case 0x44: {  // Convert T: latch temperature with the undefined LSBs cleared
+        static const uint8_t masks[4] = { 0xF8, 0xFC, 0xFE, 0xFF };
+        uint16_t raw = (uint16_t)d.tempRaw;
+        raw &= (uint16_t)(0xFF00 | masks[(d.scratchpad[4] >> 5) & 0x03]);
+        d.scratchpad[0] = (uint8_t)raw;
+        d.scratchpad[1] = (uint8_t)(raw >> 8);
+        d.scratchpad[8] = _crc(d.scratchpad, 8);
+        _enter(d, SIM_DONE);
+        break;
+      }
+      case 0xBE: _transmit(d, d.scratchpad, 9); break;  // Read Scratchpad
+      case 0x4E: _enter(d, SIM_RX); break;               // Write Scratchpad
+      case 0x48:                                         // Copy Scratchpad
+        memcpy(d.eeprom, &d.scratchpad[2], 3);
+        _enter(d, SIM_DONE);
+        break;
+      case 0xB8:  // Recall E2
+        memcpy(&d.scratchpad[2], d.eeprom, 3);
+        d.scratchpad[8] = _crc(d.scratchpad, 8);
+        _enter(d, SIM_DONE);
+        break;
+      case 0xB4: _enter(d, SIM_POWER); break;  // Read Power Supply
+      default: d.state = SIM_IDLE; break;
+    }
+  }
+};
+
+#endif
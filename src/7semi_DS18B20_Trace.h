@@ -0,0 +1,367 @@
+/***************************************************************************************************
+//  7semi_DS18B20_Trace.h - bus event trace recorder and replay transport
+//  Written for the 7semi sensor platform
+//
+//  DS18B20_Trace is a fixed ring buffer of timestamped bus events. DS18B20_TraceBusT wraps any
+//  bus, forwards every call and records it; the driver adds strong pull-up and conversion-wait
+//  events when given the same trace with setTrace(). Recording can be stopped when a fault is
+//  seen and the buffer dumped one line per event:
+//
+//    <micros> <code> <hex value>        e.g. "1203311 R 1", "1203405 W 55", "1204212 B 50"
+//
+//    R reset (value = presence)   W byte written    P byte written with bus power   B byte read
+//    w bit written                r bit read        D depower                       Q reset search
+//    S search (value bit0 = found, bit1 = alarm search; followed by 8 B events with the ROM)
+//    U strong pull-up pin (1 on / 0 off)            Z conversion / copy wait armed (value = ms)
+//    X script (value = 1 ok / 0 failed; followed by its steps as R / W / B events)
+//
+//  A script is handed to the wrapped bus's own execute() unchanged and recorded afterwards: the
+//  resets, Match / Skip ROM and written bytes from the script, the read bytes from the result
+//  (9 per READ_CHECKED). A failed script is recorded up to its first reset, as "R 0".
+//
+//  Recording is not interrupt-safe, so nothing is recorded from servicePullup(): the "U 0"
+//  release is logged by isConversionComplete() once the deadline has passed.
+//
+//  DS18B20_ReplayBus feeds such a dump back into the driver on a host: reads, presence and
+//  search results come from the trace, writes are compared against it (mismatches counted), so
+//  the driver's handling of a field fault can be reproduced deterministically.
+//  See extras/TraceReplay for the Linux replay tool.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_TRACE_H_
+#define _7SEMI_DS18B20_TRACE_H_
+
+#include "7semi_DS18B20_Transport.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef DS18B20_TRACE_SIZE
+#define DS18B20_TRACE_SIZE 64
+#endif
+
+#define DS18B20_TRACE_RESET 'R'
+#define DS18B20_TRACE_WRITE 'W'
+#define DS18B20_TRACE_WRITE_POWER 'P'
+#define DS18B20_TRACE_READ 'B'
+#define DS18B20_TRACE_WRITE_BIT 'w'
+#define DS18B20_TRACE_READ_BIT 'r'
+#define DS18B20_TRACE_DEPOWER 'D'
+#define DS18B20_TRACE_RESET_SEARCH 'Q'
+#define DS18B20_TRACE_SEARCH 'S'
+#define DS18B20_TRACE_PULLUP 'U'
+#define DS18B20_TRACE_WAIT 'Z'
+#define DS18B20_TRACE_SCRIPT 'X'
+
+// DS18B20_TraceEvent: one recorded event.
+struct DS18B20_TraceEvent {
+  uint32_t us;     // micros() when recorded
+  uint16_t value;  // byte / bit / presence / ms, depending on type
+  char type;       // DS18B20_TRACE_*
+};
+
+class DS18B20_Trace {
+public:
+  DS18B20_Trace()
+    : _head(0), _count(0), _total(0), _enabled(true) {}
+
+  // record(): append an event, overwriting the oldest when full.
+  void record(char type, uint16_t value) {
+    if (!_enabled) return;
+    DS18B20_TraceEvent &e = _events[_head];
+    e.us = micros();
+    e.value = value;
+    e.type = type;
+    _head = (uint16_t)((_head + 1) % DS18B20_TRACE_SIZE);
+    if (_count < DS18B20_TRACE_SIZE) _count++;
+    _total++;
+  }
+
+  // setEnabled(): stop recording (e.g. on a fault) to keep the events leading up to it.
+  void setEnabled(bool enabled) { _enabled = enabled; }
+
+  void clear() {
+    _head = 0;
+    _count = 0;
+    _total = 0;
+  }
+
+  // count(): events held; get(): event i, 0 = oldest.
+  uint16_t count() const { return _count; }
+  bool get(uint16_t i, DS18B20_TraceEvent &event) const {
+    if (i >= _count) return false;
+    event = _events[(uint16_t)((_head + DS18B20_TRACE_SIZE - _count + i) % DS18B20_TRACE_SIZE)];
+    return true;
+  }
+
+  // dropped(): events overwritten since the last clear().
+  uint32_t dropped() const { return _total - _count; }
+
+  // format(): dump line for one event (no newline). Returns the length.
+  static int format(const DS18B20_TraceEvent &event, char *buf, size_t size) {
+    return snprintf(buf, size, "%lu %c %X", (unsigned long)event.us, event.type, (unsigned)event.value);
+  }
+
+  // parse(): read one dump line. Returns false for empty / malformed lines.
+  static bool parse(const char *line, DS18B20_TraceEvent &event) {
+    char *end;
+    unsigned long us = strtoul(line, &end, 10);
+    if (end == line || *end != ' ') return false;
+    char type = end[1];
+    if (type == 0 || end[2] != ' ') return false;
+    const char *v = end + 3;
+    unsigned long value = strtoul(v, &end, 16);
+    if (end == v) return false;
+    event.us = (uint32_t)us;
+    event.type = type;
+    event.value = (uint16_t)value;
+    return true;
+  }
+
+private:
+  DS18B20_TraceEvent _events[DS18B20_TRACE_SIZE];
+  uint16_t _head;
+  uint16_t _count;
+  uint32_t _total;
+  bool _enabled;
+};
+
+// DS18B20_TraceBusT: recording decorator around any bus (DS18B20_Transport or DS18B20_OneWireBus).
+template <class Inner>
+class DS18B20_TraceBusT : public DS18B20_Transport {
+public:
+  DS18B20_TraceBusT(Inner &inner, DS18B20_Trace &trace)
+    : _inner(inner), _trace(trace) {}
+
+  uint8_t reset() override {
+    uint8_t presence = _inner.reset();
+    _trace.record(DS18B20_TRACE_RESET, presence);
+    return presence;
+  }
+
+  void writeBit(uint8_t v) override {
+    _inner.writeBit(v);
+    _trace.record(DS18B20_TRACE_WRITE_BIT, v ? 1 : 0);
+  }
+
+  uint8_t readBit() override {
+    uint8_t v = _inner.readBit();
+    _trace.record(DS18B20_TRACE_READ_BIT, v);
+    return v;
+  }
+
+  void select(const uint8_t rom[8]) override {
+    write(0x55);
+    writeBytes(rom, 8);
+  }
+
+  void skip() override { write(0xCC); }
+
+  void write(uint8_t v, uint8_t power = 0) override {
+    _inner.write(v, power);
+    _trace.record(power ? DS18B20_TRACE_WRITE_POWER : DS18B20_TRACE_WRITE, v);
+  }
+
+  uint8_t read() override {
+    uint8_t v = _inner.read();
+    _trace.record(DS18B20_TRACE_READ, v);
+    return v;
+  }
+
+  // batched transfers stay batched on the inner bus, events are recorded per byte
+  void writeBytes(const uint8_t *buf, uint16_t len, uint8_t power = 0) override {
+    _inner.writeBytes(buf, len, power);
+    for (uint16_t i = 0; i < len; i++) _trace.record((power && i + 1 == len) ? DS18B20_TRACE_WRITE_POWER : DS18B20_TRACE_WRITE, buf[i]);
+  }
+
+  void readBytes(uint8_t *buf, uint16_t len) override {
+    _inner.readBytes(buf, len);
+    for (uint16_t i = 0; i < len; i++) _trace.record(DS18B20_TRACE_READ, buf[i]);
+  }
+
+  void flush() override { _inner.flush(); }
+
+  void depower() override {
+    _inner.depower();
+    _trace.record(DS18B20_TRACE_DEPOWER, 0);
+  }
+
+  void resetSearch() override {
+    _inner.resetSearch();
+    _trace.record(DS18B20_TRACE_RESET_SEARCH, 0);
+  }
+
+  // triplet(): hardware triplets stay on the inner bus; recorded as the equivalent bit slots
+  uint8_t triplet(uint8_t direction) override {
+    uint8_t t = _inner.triplet(direction);
+    _trace.record(DS18B20_TRACE_READ_BIT, t & 0x01);
+    _trace.record(DS18B20_TRACE_READ_BIT, (t >> 1) & 0x01);
+    if ((t & 0x03) != 0x03) _trace.record(DS18B20_TRACE_WRITE_BIT, (t >> 2) & 0x01);
+    return t;
+  }
+
+  bool search(uint8_t rom[8], bool alarmOnly = false) override {
+    bool found = _inner.search(rom, alarmOnly);
+    _trace.record(DS18B20_TRACE_SEARCH, (uint16_t)((found ? 1 : 0) | (alarmOnly ? 2 : 0)));
+    for (uint8_t i = 0; found && i < 8; i++) _trace.record(DS18B20_TRACE_READ, rom[i]);
+    return found;
+  }
+
+  // execute(): the inner bus runs the script its own way (batched, sysfs, step by step)
+  bool execute(const DS18B20_Script &script, uint8_t *rx) override {
+    bool ok = _inner.execute(script, rx);
+    _trace.record(DS18B20_TRACE_SCRIPT, ok ? 1 : 0);
+    const uint8_t *p = script.data();
+    const uint8_t *end = p + script.length();
+    while (p < end) {
+      switch (*p++) {
+        case DS18B20_OP_RESET:
+          _trace.record(DS18B20_TRACE_RESET, ok ? 1 : 0);
+          if (!ok) return false;
+          break;
+        case DS18B20_OP_MATCH:
+          _trace.record(DS18B20_TRACE_WRITE, 0x55);
+          for (uint8_t i = 0; i < 8; i++) _trace.record(DS18B20_TRACE_WRITE, p[i]);
+          p += 8;
+          break;
+        case DS18B20_OP_SKIP:
+          _trace.record(DS18B20_TRACE_WRITE, 0xCC);
+          break;
+        case DS18B20_OP_WRITE:
+          for (uint8_t i = 0; i < p[0]; i++) _trace.record(DS18B20_TRACE_WRITE, p[1 + i]);
+          p += 1 + p[0];
+          break;
+        case DS18B20_OP_READ:
+          for (uint8_t i = 0; i < p[0]; i++) _trace.record(DS18B20_TRACE_READ, rx[i]);
+          rx += *p++;
+          break;
+        case DS18B20_OP_READ_CHECKED:
+          for (uint8_t i = 0; i < 9; i++) _trace.record(DS18B20_TRACE_READ, rx[i]);
+          rx += 10;
+          break;
+      }
+    }
+    return ok;
+  }
+
+private:
+  Inner &_inner;
+  DS18B20_Trace &_trace;
+};
+
+typedef DS18B20_TraceBusT<DS18B20_Transport> DS18B20_TraceBus;
+
+// DS18B20_ReplayBus: serves a recorded event list back to the driver.
+class DS18B20_ReplayBus : public DS18B20_Transport {
+public:
+  DS18B20_ReplayBus(const DS18B20_TraceEvent *events, uint32_t count)
+    : mismatches(0), _events(events), _count(count), _pos(0), _firstMismatch(0) {}
+
+  uint8_t reset() override { return (uint8_t)_read(DS18B20_TRACE_RESET, 0); }
+  void writeBit(uint8_t v) override { _write(DS18B20_TRACE_WRITE_BIT, v ? 1 : 0); }
+  uint8_t readBit() override { return (uint8_t)_read(DS18B20_TRACE_READ_BIT, 1); }
+  void select(const uint8_t rom[8]) override {
+    write(0x55);
+    writeBytes(rom, 8);
+  }
+  void skip() override { write(0xCC); }
+  void write(uint8_t v, uint8_t power = 0) override { _write(power ? DS18B20_TRACE_WRITE_POWER : DS18B20_TRACE_WRITE, v); }
+  uint8_t read() override { return (uint8_t)_read(DS18B20_TRACE_READ, 0xFF); }
+  void depower() override { _write(DS18B20_TRACE_DEPOWER, 0); }
+  void resetSearch() override { _write(DS18B20_TRACE_RESET_SEARCH, 0); }
+
+  bool search(uint8_t rom[8], bool alarmOnly = false) override {
+    uint16_t v = _read(DS18B20_TRACE_SEARCH, 0);
+    if (((v & 2) != 0) != alarmOnly) _mismatch();
+    if (!(v & 1)) return false;
+    for (uint8_t i = 0; i < 8; i++) rom[i] = (uint8_t)_read(DS18B20_TRACE_READ, 0xFF);
+    return true;
+  }
+
+  // execute(): replays a recorded script; READ_CHECKED verdicts are recomputed with checkRead()
+  bool execute(const DS18B20_Script &script, uint8_t *rx) override {
+    if (!script.valid()) return false;
+    bool ok = _read(DS18B20_TRACE_SCRIPT, 0) != 0;
+    const uint8_t *p = script.data();
+    const uint8_t *end = p + script.length();
+    while (p < end) {
+      switch (*p++) {
+        case DS18B20_OP_RESET:
+          if (!_read(DS18B20_TRACE_RESET, 0)) return false;
+          break;
+        case DS18B20_OP_MATCH:
+          select(p);
+          p += 8;
+          break;
+        case DS18B20_OP_SKIP:
+          skip();
+          break;
+        case DS18B20_OP_WRITE:
+          writeBytes(p + 1, p[0]);
+          p += 1 + p[0];
+          break;
+        case DS18B20_OP_READ:
+          readBytes(rx, p[0]);
+          rx += *p++;
+          break;
+        case DS18B20_OP_READ_CHECKED:
+          readBytes(rx, 9);
+          DS18B20_Script::checkRead(rx);
+          rx += 10;
+          break;
+      }
+    }
+    return ok;
+  }
+
+  // exhausted(): all transport events have been consumed.
+  bool exhausted() {
+    _skipDriverEvents();
+    return _pos >= _count;
+  }
+
+  // position(): index of the next event; firstMismatch(): event index of the first divergence.
+  uint32_t position() const { return _pos; }
+  uint32_t firstMismatch() const { return _firstMismatch; }
+
+  uint32_t mismatches;  // calls that did not match the recorded event
+
+private:
+  const DS18B20_TraceEvent *_events;
+  uint32_t _count;
+  uint32_t _pos;
+  uint32_t _firstMismatch;
+
+  // driver-side events (pull-up pin, waits) are not transport calls
+  void _skipDriverEvents() {
+    while (_pos < _count && (_events[_pos].type == DS18B20_TRACE_PULLUP || _events[_pos].type == DS18B20_TRACE_WAIT)) _pos++;
+  }
+
+  // _read(): recorded value of the next event, 'fallback' if the driver diverged
+  uint16_t _read(char type, uint16_t fallback) {
+    _skipDriverEvents();
+    if (_pos >= _count || _events[_pos].type != type) {
+      _mismatch();
+      return fallback;
+    }
+    return _events[_pos++].value;
+  }
+
+  // _write(): the next event must be this write with this value
+  void _write(char type, uint16_t value) {
+    _skipDriverEvents();
+    if (_pos >= _count || _events[_pos].type != type) {
+      _mismatch();
+      return;
+    }
+    if (_events[_pos++].value != value) _mismatch();
+  }
+
+  void _mismatch() {
+    if (mismatches++ == 0) _firstMismatch = _pos;
+  }
+};
+
+#endif
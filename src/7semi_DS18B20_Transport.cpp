@@ -0,0 +1,146 @@
+/*************************************************************************************************** 
+//  7semi_DS18B20_Transport.cpp - bit-level default implementations of the 1-Wire transport
+//  Written for the 7semi sensor platform
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#include "7semi_DS18B20_Transport.h"
+
+/**
+// Constructor: clear search state
+**/
+DS18B20_Transport::DS18B20_Transport() {
+  resetSearch();
+}
+
+/**
+// select(): Match ROM followed by the 64-bit ROM code
+**/
+void DS18B20_Transport::select(const uint8_t rom[8]) {
+  write(0x55);  // Match ROM
+  writeBytes(rom, 8);
+}
+
+/**
+// skip(): address all devices
+**/
+void DS18B20_Transport::skip() {
+  write(0xCC);  // Skip ROM
+}
+
+/**
+// write(): 8 write slots, LSB first. Plain bit-level backends cannot hold the bus high.
+**/
+void DS18B20_Transport::write(uint8_t v, uint8_t power) {
+  (void)power;
+  for (uint8_t i = 0; i < 8; i++) {
+    writeBit(v & 0x01);
+    v >>= 1;
+  }
+}
+
+/**
+// read(): 8 read slots, LSB first
+**/
+uint8_t DS18B20_Transport::read() {
+  uint8_t v = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (readBit()) v |= (uint8_t)(1 << i);
+  }
+  return v;
+}
+
+/**
+// writeBytes(): byte loop; 'power' applies to the last byte only
+**/
+void DS18B20_Transport::writeBytes(const uint8_t *buf, uint16_t len, uint8_t power) {
+  for (uint16_t i = 0; i < len; i++) write(buf[i], (i + 1 == len) ? power : 0);
+}
+
+/**
+// readBytes(): byte loop
+**/
+void DS18B20_Transport::readBytes(uint8_t *buf, uint16_t len) {
+  for (uint16_t i = 0; i < len; i++) buf[i] = read();
+}
+
+/**
+// flush(): bit-level backends write immediately
+**/
+void DS18B20_Transport::flush() {
+}
+
+/**
+// depower(): nothing to release for plain bit-level backends
+**/
+void DS18B20_Transport::depower() {
+}
+
+/**
+// triplet(): two read slots and one write slot; all remaining devices agree unless both bits are 0
+**/
+uint8_t DS18B20_Transport::triplet(uint8_t direction) {
+  uint8_t idBit = readBit();
+  uint8_t cmpBit = readBit();
+  if (idBit != cmpBit) direction = idBit;
+  else if (idBit) return 0x03;  // nobody answered: no write slot
+  writeBit(direction);
+  return (uint8_t)(idBit | (cmpBit << 1) | (direction << 2));
+}
+
+/**
+// resetSearch(): restart enumeration with the next search() call
+**/
+void DS18B20_Transport::resetSearch() {
+  _lastDiscrepancy = 0;
+  _lastDevice = false;
+  memset(_searchRom, 0, sizeof(_searchRom));
+}
+
+/**
+// search(): Maxim application note 187 search algorithm on read/read/write bit triplets
+**/
+bool DS18B20_Transport::search(uint8_t rom[8], bool alarmOnly) {
+  if (_lastDevice) return false;
+  if (!reset()) {
+    resetSearch();
+    return false;
+  }
+  write(alarmOnly ? 0xEC : 0xF0);  // Alarm Search / Search ROM
+
+  uint8_t lastZero = 0;
+  for (uint8_t bitNumber = 1; bitNumber <= 64; bitNumber++) {
+    uint8_t byteIndex = (bitNumber - 1) >> 3;
+    uint8_t mask = (uint8_t)(1 << ((bitNumber - 1) & 0x07));
+    // direction to take if devices disagree on this bit
+    uint8_t direction;
+    if (bitNumber < _lastDiscrepancy) {
+      direction = (_searchRom[byteIndex] & mask) ? 1 : 0;
+    } else {
+      direction = (bitNumber == _lastDiscrepancy) ? 1 : 0;
+    }
+    uint8_t t = triplet(direction);
+    if ((t & 0x03) == 0x03) {
+      resetSearch();  // no device took part
+      return false;
+    }
+    direction = (t >> 2) & 0x01;
+    if ((t & 0x03) == 0 && !direction) lastZero = bitNumber;
+    if (direction) _searchRom[byteIndex] |= mask;
+    else _searchRom[byteIndex] &= (uint8_t)~mask;
+  }
+
+  _lastDiscrepancy = lastZero;
+  if (_lastDiscrepancy == 0) _lastDevice = true;
+  memcpy(rom, _searchRom, 8);
+  return true;
+}
+
+/**
+// execute(): step-by-step interpreter; backends that can send a whole transaction at once override
+**/
+bool DS18B20_Transport::execute(const DS18B20_Script &script, uint8_t *rx) {
+  return DS18B20_Script::run(*this, script, rx);
+}
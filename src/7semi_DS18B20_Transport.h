@@ -0,0 +1,82 @@
+/*************************************************************************************************** 
+//  7semi_DS18B20_Transport.h - 1-Wire transport interface for the DS18B20 library
+//  Written for the 7semi sensor platform
+//
+//  DS18B20_Driver<Bus> talks to the bus only through the methods below. Any class providing
+//  them can be used as 'Bus' directly (static dispatch, e.g. DS18B20_OneWireBus), or derive
+//  from DS18B20_Transport and use DS18B20_Driver<DS18B20_Transport> for runtime-pluggable
+//  backends (bridges, UART masters, simulated buses).
+//
+//  Only reset(), writeBit() and readBit() are mandatory; byte, ROM and search functions have
+//  bit-level default implementations that backends can override with hardware-assisted ones.
+// 
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_TRANSPORT_H_
+#define _7SEMI_DS18B20_TRANSPORT_H_
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include "7semi_DS18B20_Host.h"
+#endif
+#include "7semi_DS18B20_Script.h"
+
+class DS18B20_Transport {
+public:
+  DS18B20_Transport();
+  virtual ~DS18B20_Transport() {}
+
+  // reset(): issue reset pulse; returns 1 if a presence pulse was detected.
+  virtual uint8_t reset() = 0;
+
+  // writeBit()/readBit(): single write / read time slot.
+  virtual void writeBit(uint8_t v) = 0;
+  virtual uint8_t readBit() = 0;
+
+  // select(): Match ROM (0x55) + 8 ROM bytes.
+  virtual void select(const uint8_t rom[8]);
+
+  // skip(): Skip ROM (0xCC).
+  virtual void skip();
+
+  // write(): write one byte LSB first; power != 0 keeps the bus actively driven high afterwards.
+  virtual void write(uint8_t v, uint8_t power = 0);
+
+  // read(): read one byte LSB first.
+  virtual uint8_t read();
+
+  // writeBytes()/readBytes(): batched transfers (default: byte loop).
+  virtual void writeBytes(const uint8_t *buf, uint16_t len, uint8_t power = 0);
+  virtual void readBytes(uint8_t *buf, uint16_t len);
+
+  // flush(): complete queued slots. Batching transports may defer writes until the next read or
+  // reset; the driver calls flush() before it starts timing a conversion or EEPROM copy.
+  virtual void flush();
+
+  // depower(): release an active pull-up started with write(..., power).
+  virtual void depower();
+
+  // triplet(): Search ROM triplet - read bit, read complement, then write the chosen direction.
+  // 'direction' is taken when both bits are 0 (discrepancy). Returns bit0 = id bit,
+  // bit1 = complement bit, bit2 = direction written.
+  virtual uint8_t triplet(uint8_t direction);
+
+  // resetSearch()/search(): ROM search state machine (Search ROM 0xF0, or Alarm Search 0xEC
+  // when alarmOnly is true). search() returns false when no further device is found.
+  virtual void resetSearch();
+  virtual bool search(uint8_t rom[8], bool alarmOnly = false);
+
+  // execute(): run a whole transaction script; READ steps fill 'rx' in order. Returns false if
+  // the script is invalid or a reset saw no presence pulse. Default: DS18B20_Script::run().
+  virtual bool execute(const DS18B20_Script &script, uint8_t *rx);
+
+protected:
+  uint8_t _searchRom[8];
+  uint8_t _lastDiscrepancy;
+  bool _lastDevice;
+};
+
+#endif
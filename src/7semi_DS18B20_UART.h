@@ -0,0 +1,227 @@
+/***************************************************************************************************
+//  7semi_DS18B20_UART.h - 1-Wire over a UART (DS2480B-style "UART trick")
+//  Written for the 7semi sensor platform
+//
+//  TX and RX are tied to the 1-Wire line through an open-drain stage (diode or transistor).
+//  At 9600 baud a 0xF0 byte is a reset pulse and a changed echo is a presence pulse; at
+//  115200 baud each UART byte is one time slot: 0xFF writes 1 / reads, 0x00 writes 0, and an
+//  echo of 0xFF means the slot read 1. All timing is done by the UART (and its DMA).
+//
+//  Slots are queued and sent as one buffer: writes are deferred until the next read, reset or
+//  flush(). execute() also queues the read slots and decodes them from the echoes afterwards,
+//  so every script step between two resets is one transfer - Match ROM + 0xBE + 9 read bytes
+//  is a single 152-byte transfer. On Arduino the buffer is streamed in DS18B20_UART_CHUNK
+//  pieces so echoes never overrun the RX FIFO.
+//
+//  'Port' needs begin(baud), write(buf, len), readBytes(buf, len), available(), read() and
+//  flush() - HardwareSerial on Arduino, DS18B20_HostSerial on Linux.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_UART_H_
+#define _7SEMI_DS18B20_UART_H_
+
+#include "7semi_DS18B20_Transport.h"
+
+// slot bytes per transfer (8 per 1-Wire byte); Match ROM + command + scratchpad needs 152
+#ifndef DS18B20_UART_BUFFER
+#define DS18B20_UART_BUFFER 160
+#endif
+
+// slot bytes written before their echoes are collected; must fit the port's RX buffer
+#ifndef DS18B20_UART_CHUNK
+#if defined(ARDUINO)
+#define DS18B20_UART_CHUNK 32
+#else
+#define DS18B20_UART_CHUNK DS18B20_UART_BUFFER
+#endif
+#endif
+
+// read steps one transfer can carry (execute())
+#define DS18B20_UART_READS 4
+
+#define DS18B20_UART_RESET_BAUD 9600
+#define DS18B20_UART_SLOT_BAUD 115200
+
+template <class Port>
+class DS18B20_UARTBusT : public DS18B20_Transport {
+public:
+  explicit DS18B20_UARTBusT(Port &port)
+    : _port(port), _len(0), _reads(0), _transfers(0) {}
+
+  // begin(): open the port at slot speed.
+  void begin() {
+    _port.begin(DS18B20_UART_SLOT_BAUD);
+  }
+
+  uint8_t reset() override {
+    flush();
+    _port.begin(DS18B20_UART_RESET_BAUD);
+    _drain();
+    uint8_t tx = 0xF0;
+    uint8_t rx = 0xF0;
+    _port.write(&tx, 1);
+    bool echoed = (_port.readBytes(&rx, 1) == 1);
+    _port.begin(DS18B20_UART_SLOT_BAUD);
+    // no echo at all means TX/RX are not connected to the bus
+    return (echoed && rx != 0xF0) ? 1 : 0;
+  }
+
+  void writeBit(uint8_t v) override {
+    _queue(v ? 0xFF : 0x00);
+  }
+
+  uint8_t readBit() override {
+    _queue(0xFF);
+    uint16_t pos = _len - 1;
+    _transfer();
+    return (_buf[pos] == 0xFF) ? 1 : 0;
+  }
+
+  void write(uint8_t v, uint8_t power = 0) override {
+    if (_len + 8 > DS18B20_UART_BUFFER) _transfer();
+    for (uint8_t i = 0; i < 8; i++) {
+      _buf[_len++] = (v & 0x01) ? 0xFF : 0x00;
+      v >>= 1;
+    }
+    if (power) flush();  // no strong pull-up on a UART; at least send the byte now
+  }
+
+  uint8_t read() override {
+    uint8_t v;
+    readBytes(&v, 1);
+    return v;
+  }
+
+  void readBytes(uint8_t *buf, uint16_t len) override {
+    _queueRead(buf, len);
+    _transfer();  // queued writes go out in the same buffer
+  }
+
+  void flush() override {
+    if (_len) _transfer();
+  }
+
+  // execute(): queue every step up to the next reset (or the end) and send it as one transfer;
+  // READ_CHECKED reads all 9 bytes in that buffer and takes its verdict from checkRead().
+  bool execute(const DS18B20_Script &script, uint8_t *rx) override {
+    if (!script.valid()) return false;
+    const uint8_t *p = script.data();
+    const uint8_t *end = p + script.length();
+    uint8_t *checked[DS18B20_UART_READS];
+    uint8_t nChecked = 0;
+    bool ok = true;
+    while (ok && p < end) {
+      switch (*p++) {
+        case DS18B20_OP_RESET:
+          ok = (reset() != 0);  // reset() sends the queued steps first
+          break;
+        case DS18B20_OP_MATCH:
+          select(p);
+          p += 8;
+          break;
+        case DS18B20_OP_SKIP:
+          skip();
+          break;
+        case DS18B20_OP_WRITE:
+          writeBytes(p + 1, p[0]);
+          p += 1 + p[0];
+          break;
+        case DS18B20_OP_READ:
+          _queueRead(rx, p[0]);
+          rx += p[0];
+          p++;
+          break;
+        case DS18B20_OP_READ_CHECKED:
+          if (nChecked == DS18B20_UART_READS) {
+            ok = false;
+            break;
+          }
+          checked[nChecked++] = rx;
+          _queueRead(rx, 9);
+          rx += 10;
+          break;
+        default:
+          ok = false;
+      }
+    }
+    flush();
+    for (uint8_t i = 0; i < nChecked; i++) DS18B20_Script::checkRead(checked[i]);
+    return ok;
+  }
+
+  // transfers(): number of buffer transfers so far (batching statistics).
+  uint32_t transfers() const { return _transfers; }
+
+private:
+  Port &_port;
+  uint8_t _buf[DS18B20_UART_BUFFER];
+  uint16_t _len;
+  struct {
+    uint8_t *dest;
+    uint16_t slot;
+    uint16_t len;
+  } _read[DS18B20_UART_READS];  // queued read slots, decoded after the transfer
+  uint8_t _reads;
+  uint32_t _transfers;
+
+  void _queue(uint8_t slot) {
+    if (_len >= DS18B20_UART_BUFFER) _transfer();
+    _buf[_len++] = slot;
+  }
+
+  // _queueRead(): 8 read slots per byte into 'dest', transferring early only when the buffer fills
+  void _queueRead(uint8_t *dest, uint16_t len) {
+    while (len) {
+      if (_len + 8 > DS18B20_UART_BUFFER || _reads == DS18B20_UART_READS) _transfer();
+      uint16_t n = (DS18B20_UART_BUFFER - _len) / 8;
+      if (n > len) n = len;
+      _read[_reads].dest = dest;
+      _read[_reads].slot = _len;
+      _read[_reads].len = n;
+      _reads++;
+      memset(&_buf[_len], 0xFF, n * 8);
+      _len += n * 8;
+      dest += n;
+      len -= n;
+    }
+  }
+
+  // _transfer(): send all queued slots, echoes overwrite the buffer; queued reads are decoded
+  void _transfer() {
+    for (uint16_t off = 0; off < _len; off += DS18B20_UART_CHUNK) {
+      uint16_t n = _len - off;
+      if (n > DS18B20_UART_CHUNK) n = DS18B20_UART_CHUNK;
+      _port.write(&_buf[off], n);
+      if (_port.readBytes(&_buf[off], n) != n) memset(&_buf[off], 0x00, n);  // lost echo: read as 0
+    }
+    for (uint8_t r = 0; r < _reads; r++) {
+      for (uint16_t i = 0; i < _read[r].len; i++) _read[r].dest[i] = _decode(&_buf[_read[r].slot + i * 8]);
+    }
+    _reads = 0;
+    _len = 0;
+    _transfers++;
+  }
+
+  // _drain(): drop stale input before a reset
+  void _drain() {
+    _port.flush();
+    while (_port.available()) _port.read();
+  }
+
+  static uint8_t _decode(const uint8_t *slots) {
+    uint8_t v = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+      if (slots[i] == 0xFF) v |= (uint8_t)(1 << i);
+    }
+    return v;
+  }
+};
+
+#if defined(ARDUINO)
+typedef DS18B20_UARTBusT<HardwareSerial> DS18B20_UARTBus;
+#endif
+
+#endif
@@ -0,0 +1,70 @@
+/***************************************************************************************************
+//  7semi_DS18B20_UARTSim.h - UART port model for testing DS18B20_UARTBusT on a host
+//  Written for the 7semi sensor platform
+//
+//  Turns UART bytes into 1-Wire activity on an attached transport (e.g. DS18B20_SimBus) and
+//  queues the echo a UART tied to the bus would receive: at 9600 baud 0xF0 is a reset pulse,
+//  at 115200 baud 0xFF is a read slot and any other byte a write-0 slot.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_UARTSIM_H_
+#define _7SEMI_DS18B20_UARTSIM_H_
+
+#include "7semi_DS18B20_UART.h"
+
+class DS18B20_UARTSim {
+public:
+  explicit DS18B20_UARTSim(DS18B20_Transport &bus)
+    : writeCalls(0), _bus(bus), _baud(0), _head(0), _tail(0) {}
+
+  void begin(unsigned long baud) { _baud = baud; }
+
+  size_t write(const uint8_t *buf, size_t len) {
+    writeCalls++;
+    for (size_t i = 0; i < len; i++) {
+      uint8_t echo = buf[i];
+      if (_baud == DS18B20_UART_RESET_BAUD) {
+        if (buf[i] == 0xF0 && _bus.reset()) echo = 0xE0;  // presence pulse shortens the echo
+      } else if (buf[i] == 0xFF) {
+        if (!_bus.readBit()) echo = 0xFE;  // device held the line low
+      } else {
+        _bus.writeBit(0);
+        echo = 0x00;
+      }
+      _echo[_head] = echo;
+      _head = (uint16_t)((_head + 1) % sizeof(_echo));
+    }
+    return len;
+  }
+
+  size_t readBytes(uint8_t *buf, size_t len) {
+    size_t n = 0;
+    while (n < len && available()) buf[n++] = (uint8_t)read();
+    return n;
+  }
+
+  int available() { return (int)((_head + sizeof(_echo) - _tail) % sizeof(_echo)); }
+
+  int read() {
+    if (_head == _tail) return -1;
+    uint8_t v = _echo[_tail];
+    _tail = (uint16_t)((_tail + 1) % sizeof(_echo));
+    return v;
+  }
+
+  void flush() {}
+
+  uint32_t writeCalls;  // port write() calls (one per transfer chunk)
+
+private:
+  DS18B20_Transport &_bus;
+  unsigned long _baud;
+  uint8_t _echo[DS18B20_UART_BUFFER + 1];
+  uint16_t _head;
+  uint16_t _tail;
+};
+
+#endif
@@ -0,0 +1,1589 @@
+/*************************************************************************************************** 
+//  7semi_DS18B20_impl.h - DS18B20_Driver<Bus, Config> template implementation
+//  Written for the 7semi sensor platform
+//
+//  Included from 7semi_DS18B20.h; uses the Bus transport to perform ROM & memory functions,
+//  supports multi-device, alarms, scratchpad/EEPROM operations, parasite power handling.
+//
+//  Author: 7semi
+//  License: MIT
+*****************************************************************************************************/
+
+#ifndef _7SEMI_DS18B20_IMPL_H_
+#define _7SEMI_DS18B20_IMPL_H_
+
+/**
+// Constructor: store transport reference and pins
+**/
+template <class Bus, class Config>
+DS18B20_Driver<Bus, Config>::DS18B20_Driver(Bus &bus, int8_t strongPullupPin)
+  : _bus(bus), _strongPullupPin(strongPullupPin) {
+  _devices = 0;
+  _cacheStore = nullptr;
+  _tagMode = false;
+  _busParasite = Config::parasite;  // unknown until checkBusPower(): query devices individually
+  _convStart = 0;
+  _convUs = 0;
+  _pullupOn = false;
+  _pullupTraced = false;
+  _convPending = false;
+  for (uint8_t i = 0; i < DS18B20_MAX_CALLBACKS; i++) _listeners[i].callback = nullptr;
+  _sweepInterval = 1000;
+  _lastSweep = 0;
+#if DS18B20_SCHEDULER
+  for (uint8_t i = 0; i < Config::maxDevices; i++) {
+    _period[i] = 0;
+    _deadline[i] = 0;
+    _priority[i] = 0;
+  }
+#endif
+#if DS18B20_PIPELINE
+  _pipelined = false;
+  _pipeBusy = 0;
+#endif
+  _rescanSweeps = 0;
+  _sweepCount = 0;
+  _sweepState = DS18B20_SWEEP_IDLE;
+  _reconvertIndex = 0;
+#if DS18B20_HEALTH
+  _searchErrors = 0;
+  clearHealth();
+#endif
+#if DS18B20_LATENCY
+  clearLatency();
+#endif
+  _trace = nullptr;
+}
+
+/**
+// begin(): restore devices from cache if possible, otherwise reset search and scan devices
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::begin() {
+  _strongPullupPin.output();  // pin mode set once, toggles are plain register writes
+  checkBusPower();
+  if (_cacheStore && loadCache() && _verifyCachedDevices()) return true;
+  _bus.resetSearch();
+  _devices = searchDevices();
+  if (_cacheStore && _devices > 0) saveCache();
+  return (_devices > 0);
+}
+
+/**
+// setCacheStore(): attach persistent store used by begin(), loadCache() and saveCache()
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::setCacheStore(DS18B20_CacheStore *store) {
+  _cacheStore = store;
+}
+
+/**
+// loadCache(): read header, records and CRC trailer; table is left empty if anything is invalid
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::loadCache() {
+  if (!_cacheStore) return false;
+  uint8_t hdr[DS18B20_CACHE_HEADER_SIZE];
+  if (!_cacheStore->read(0, hdr, sizeof(hdr))) return false;
+  if (hdr[0] != DS18B20_CACHE_MAGIC || hdr[1] != DS18B20_CACHE_VERSION) return false;
+  if (hdr[2] == 0 || hdr[2] > Config::maxDevices) return false;
+
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < sizeof(hdr); i++) crc = _crc8Update(crc, hdr[i]);
+
+  uint16_t offset = DS18B20_CACHE_HEADER_SIZE;
+  uint8_t rec[DS18B20_CACHE_RECORD_SIZE];
+  for (uint8_t i = 0; i < hdr[2]; i++) {
+    if (!_cacheStore->read(offset, rec, sizeof(rec))) {
+      _devices = 0;
+      return false;
+    }
+    for (uint8_t j = 0; j < sizeof(rec); j++) crc = _crc8Update(crc, rec[j]);
+    _setRom(i, rec);
+    _flags[i] = rec[9];
+    _storeMetadata(i, rec[8], (int8_t)rec[10], (int8_t)rec[11]);
+    offset += sizeof(rec);
+  }
+
+  uint8_t stored;
+  if (!_cacheStore->read(offset, &stored, 1) || stored != crc) {
+    _devices = 0;
+    return false;
+  }
+  _devices = hdr[2];
+  _sortTable();  // caches written by older versions may be unsorted
+  _buildTagIndex();
+  return true;
+}
+
+/**
+// saveCache(): write header, one record per device (ROM + metadata) and CRC trailer
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::saveCache() {
+  if (!_cacheStore || _devices == 0) return false;
+  uint8_t hdr[DS18B20_CACHE_HEADER_SIZE] = { DS18B20_CACHE_MAGIC, DS18B20_CACHE_VERSION, _devices };
+  if (!_cacheStore->write(0, hdr, sizeof(hdr))) return false;
+
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < sizeof(hdr); i++) crc = _crc8Update(crc, hdr[i]);
+
+  uint16_t offset = DS18B20_CACHE_HEADER_SIZE;
+  uint8_t rec[DS18B20_CACHE_RECORD_SIZE];
+  for (uint8_t i = 0; i < _devices; i++) {
+    _copyRom(i, rec);
+    rec[8] = _tableResolution(i);
+    rec[9] = _flags[i];
+    rec[10] = Config::alarms ? (uint8_t)_th[i] : 0;
+    rec[11] = Config::alarms ? (uint8_t)_tl[i] : 0;
+    if (!_cacheStore->write(offset, rec, sizeof(rec))) return false;
+    for (uint8_t j = 0; j < sizeof(rec); j++) crc = _crc8Update(crc, rec[j]);
+    offset += sizeof(rec);
+  }
+  return _cacheStore->write(offset, &crc, 1);
+}
+
+/**
+// searchDevices(): search and store addresses up to Config::maxDevices, sorted by ROM64
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::searchDevices() {
+  DS18B20_MEASURE(DS18B20_LAT_SEARCH);
+  _devices = 0;
+  uint8_t addr[8];
+  for (bool first = true; _nextRom(addr, first); first = false) {
+    if (_devices < Config::maxDevices) {
+      _setRom(_devices, addr);
+      // CRC check: crc8 helper used here
+      if (crc8(addr, 7) != addr[7]) {
+        // CRC failed -> skip storing this device
+#if DS18B20_HEALTH
+        _searchErrors++;
+#endif
+      } else {
+        _flags[_devices] = 0;
+        _devices++;
+      }
+    } else {
+      break;
+    }
+  }
+  _bus.resetSearch();
+  _sortTable();
+  for (uint8_t i = 0; i < _devices; i++) _cacheMetadata(i);
+  _buildTagIndex();
+#if DS18B20_FILTERS
+  // indices may now refer to other devices: no sensor inherits another one's filter
+  for (uint8_t i = 0; i < _devices; i++) _filter[i].configure(DS18B20_FILTER_NONE, 0, 0);
+#endif
+#if DS18B20_SCHEDULER
+  for (uint8_t i = 0; i < _devices; i++) {  // same for schedules: sweep interval, all due now
+    _period[i] = 0;
+    _priority[i] = 0;
+    _deadline[i] = millis();
+  }
+#endif
+#if DS18B20_HEALTH
+  clearHealth();  // indices may now refer to other devices
+#endif
+  return _devices;
+}
+
+/**
+// getAddress(): copy stored address by index
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::getAddress(uint8_t index, uint8_t addr[8]) {
+  if (index >= _devices) return false;
+  _copyRom(index, addr);
+  return true;
+}
+
+/**
+// indexOf(): binary search by ROM64 in the sorted device table
+**/
+template <class Bus, class Config>
+int16_t DS18B20_Driver<Bus, Config>::indexOf(uint64_t rom64) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return indexOf(addr);
+}
+
+template <class Bus, class Config>
+int16_t DS18B20_Driver<Bus, Config>::indexOf(const uint8_t addr[8]) {
+  int16_t lo = 0;
+  int16_t hi = (int16_t)_devices - 1;
+  uint8_t buf[8];
+  while (lo <= hi) {
+    int16_t mid = (lo + hi) / 2;
+    int8_t c = _compareROM(_rom(mid, buf), addr);
+    if (c == 0) return mid;
+    if (c < 0) lo = mid + 1;
+    else hi = mid - 1;
+  }
+  return -1;
+}
+
+/**
+// setTagMode(): enable/disable TH/TL tag interpretation and (re)build the tag index
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::setTagMode(bool enable) {
+  _tagMode = enable && Config::alarms;  // tags live in the TH/TL bytes
+  _buildTagIndex();
+}
+
+/**
+// setTag(): write tag into TH/TL keeping the cached config byte, optionally copy to EEPROM
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::setTag(uint8_t index, uint16_t tag, bool persistToEeprom) {
+  if (!Config::alarms || index >= _devices) return false;
+  uint8_t buf[8];
+  const uint8_t *addr = _rom(index, buf);
+  uint8_t config;
+  if (_flags[index] & DS18B20_FLAG_VALID) {
+    config = _resolutionToConfig(_tableResolution(index));
+  } else {
+    uint8_t sp[9];
+    if (!readScratchpad(addr, sp)) return false;
+    config = sp[4];
+  }
+  int8_t th = (int8_t)(tag >> 8);
+  int8_t tl = (int8_t)(tag & 0xFF);
+  if (!writeScratchpad(addr, th, tl, config)) return false;
+  if (persistToEeprom && !copyScratchpad(addr)) return false;
+  _th[index] = th;
+  _tl[index] = tl;
+  _buildTagIndex();
+  return true;
+}
+
+/**
+// getTag(): combine cached TH (high byte) and TL (low byte)
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::getTag(uint8_t index, uint16_t &tag) {
+  if (!Config::alarms || index >= _devices) return false;
+  tag = ((uint16_t)(uint8_t)_th[index] << 8) | (uint8_t)_tl[index];
+  return true;
+}
+
+/**
+// indexOfTag(): binary search over the tag-sorted index
+**/
+template <class Bus, class Config>
+int16_t DS18B20_Driver<Bus, Config>::indexOfTag(uint16_t tag) {
+  if (!_tagMode) return -1;
+  int16_t lo = 0;
+  int16_t hi = (int16_t)_devices - 1;
+  uint16_t t = 0;
+  while (lo <= hi) {
+    int16_t mid = (lo + hi) / 2;
+    getTag(_tagOrder[mid], t);
+    if (t == tag) return _tagOrder[mid];
+    if (t < tag) lo = mid + 1;
+    else hi = mid - 1;
+  }
+  return -1;
+}
+
+/**
+// getDeviceInfo(): copy cached metadata by index
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::getDeviceInfo(uint8_t index, DS18B20_DeviceInfo &info) {
+  if (index >= _devices) return false;
+  info.resolution = _tableResolution(index);
+  info.th = Config::alarms ? _th[index] : 0;
+  info.tl = Config::alarms ? _tl[index] : 0;
+  info.parasite = (_flags[index] & DS18B20_FLAG_PARASITE) != 0;
+  info.valid = (_flags[index] & DS18B20_FLAG_VALID) != 0;
+  return true;
+}
+
+/**
+// readTemperature(): start conversion, wait appropriate time, read scratchpad and compute °C.
+**/
+template <class Bus, class Config>
+float DS18B20_Driver<Bus, Config>::readTemperature(const uint8_t addr[8]) {
+  DS18B20_MEASURE(DS18B20_LAT_READ_TEMPERATURE);
+  // Start conversion; pull-up and wait time according to the device's power mode and resolution
+  if (_convPending) _waitConversion();  // e.g. a poll() sweep in progress
+  if (!startConversion(addr)) return NAN;
+  _waitConversion();
+
+  // Read scratchpad; a power-on 85 °C value (brown-out during the conversion) gets exactly one
+  // re-conversion, a repeated 85 °C is a genuine reading
+  int16_t raw;
+  uint8_t status = _readClassified(addr, raw);
+  if (status == DS18B20_STATUS_POWER_ON_RESET) {
+    _recordHealth(addr, DS18B20_HEALTH_RETRY);
+    if (!startConversion(addr)) return NAN;
+    _waitConversion();
+    status = _readClassified(addr, raw);
+    if (status == DS18B20_STATUS_POWER_ON_RESET) status = DS18B20_STATUS_OK;
+  }
+  if (status != DS18B20_STATUS_OK) return NAN;
+
+  // scaling 1/16 at every resolution; a fixed resolution also masks the undefined low bits
+  return _Res::celsius(raw);
+}
+
+/**
+// readRawTemperature(): read raw 16-bit signed temp register
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::readRawTemperature(const uint8_t addr[8], int16_t &raw) {
+  uint8_t scratch[9];
+  if (!readScratchpad(addr, scratch)) return false;
+  raw = (int16_t)((scratch[1] << 8) | scratch[0]);
+  return true;
+}
+
+/**
+// readAllRaw(): one scratchpad read per table entry, results stored in place (no staging copies)
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::readAllRaw(int16_t *raw, uint8_t *status, uint32_t *timestamps, uint8_t max) {
+  if (_convPending) _waitConversion();  // parasite devices need the bus until the conversion ends
+  uint8_t n = (_devices < max) ? _devices : max;
+  uint8_t ok = 0;
+  uint8_t buf[8];
+  for (uint8_t i = 0; i < n; i++) {
+    uint8_t s = _readClassified(_rom(i, buf), raw[i]);
+    if (status) status[i] = s;
+    if (timestamps) timestamps[i] = millis();
+    if (s == DS18B20_STATUS_OK) ok++;
+  }
+  return ok;
+}
+
+/**
+// setResolution(): set R1/R0 bits in config byte (9..12). Optionally persist to EEPROM.
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::setResolution(const uint8_t addr[8], uint8_t resolution, bool persistToEeprom) {
+  if (resolution < 9 || resolution > 12) return false;
+  if (Config::resolution && resolution != Config::resolution) return false;
+  // read current scratchpad to keep TH/TL
+  uint8_t sp[9];
+  if (!readScratchpad(addr, sp)) return false;
+  int8_t th = (int8_t)sp[2];
+  int8_t tl = (int8_t)sp[3];
+  uint8_t config = _resolutionToConfig(resolution);
+  // Write scratchpad TH, TL, config (Write Scratchpad 0x4E)
+  if (!writeScratchpad(addr, th, tl, config)) return false;
+  if (persistToEeprom) {
+    if (!copyScratchpad(addr)) return false;
+  }
+  return true;
+}
+
+/**
+// getResolution(): parse scratchpad config byte and convert to resolution 9..12
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::getResolution(const uint8_t addr[8]) {
+  uint8_t sp[9];
+  if (!readScratchpad(addr, sp)) return 0;
+  return _configToResolution(sp[4]);
+}
+
+/**
+// setAlarms(): write TH and TL into scratchpad; optionally persist
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::setAlarms(const uint8_t addr[8], int8_t th, int8_t tl, bool persistToEeprom) {
+  if (!Config::alarms) return false;
+  // read config
+  uint8_t sp[9];
+  if (!readScratchpad(addr, sp)) return false;
+  uint8_t cfg = sp[4];
+  if (!writeScratchpad(addr, th, tl, cfg)) return false;
+  if (persistToEeprom) {
+    return copyScratchpad(addr);
+  }
+  return true;
+}
+
+/**
+// getAlarms(): read TH/TL from scratchpad
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::getAlarms(const uint8_t addr[8], int8_t &th, int8_t &tl) {
+  if (!Config::alarms) return false;
+  uint8_t sp[9];
+  if (!readScratchpad(addr, sp)) return false;
+  th = (int8_t)sp[2];
+  tl = (int8_t)sp[3];
+  return true;
+}
+
+/**
+// alarmSearch(): perform Alarm Search (0xEC) and return first found device address
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::alarmSearch(uint8_t foundAddr[8]) {
+  // Alarm Search (0xEC): only devices whose last conversion tripped TH/TL take part.
+  if (!Config::alarms) return false;
+  _bus.resetSearch();
+  if (!_bus.search(foundAddr, true)) return false;
+  if (crc8(foundAddr, 7) != foundAddr[7]) return false;
+  return true;
+}
+
+/**
+// verifyPresence(): a full directed search path means the device is on the bus
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::verifyPresence(const uint8_t addr[8]) {
+  return _directedSearch(addr) == 64;
+}
+
+/**
+// verifyPresence(): directed search per ROM; skips ROMs that share the prefix up to the bit where
+// the previous search ran into an empty branch
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::verifyPresence(const uint8_t (*roms)[8], uint8_t count, bool *present) {
+  uint8_t found = 0;
+  uint8_t failBit = 64;  // bit where the previous ROM's path ended (64 = complete)
+  uint8_t prev = 0;
+  for (uint8_t n = 0; n < count; n++) {
+    // next ROM in search order after 'prev' (ties by index); no sort buffer needed
+    uint8_t i = count;
+    for (uint8_t j = 0; j < count; j++) {
+      if (n > 0) {
+        int8_t c = _compareSearchOrder(roms[prev], roms[j]);
+        if (c > 0 || (c == 0 && j <= prev)) continue;
+      }
+      if (i == count) {
+        i = j;
+        continue;
+      }
+      int8_t c = _compareSearchOrder(roms[j], roms[i]);
+      if (c < 0 || (c == 0 && j < i)) i = j;
+    }
+    if (n > 0 && failBit < 64) {
+      // same bits up to and including failBit: the same empty branch
+      uint8_t same = 0;
+      while (same <= failBit && !(((roms[i][same >> 3] ^ roms[prev][same >> 3]) >> (same & 0x07)) & 0x01)) same++;
+      if (same > failBit) {
+        present[i] = false;
+        prev = i;
+        continue;
+      }
+    }
+    failBit = _directedSearch(roms[i]);
+    present[i] = (failBit == 64);
+    if (present[i]) found++;
+    prev = i;
+  }
+  return found;
+}
+
+/**
+// isParasitePower(): issue Read Power Supply (0xB4) on device; returns true for parasite (0) else true external
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::isParasitePower(const uint8_t addr[8]) {
+  return !_isExternalPowered(addr);  // no bus traffic on external-only buses or for cached devices
+}
+
+/**
+// readScratchpad(): read scratchpad bytes and verify CRC
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::readScratchpad(const uint8_t addr[8], uint8_t buffer[9]) {
+  uint8_t verdict;
+  if (!_readChecked(addr, buffer, verdict)) return false;
+  if (verdict == DS18B20_CHECK_ABORTED) _recordRead(addr, _classifyChecked(buffer, verdict));
+  if (verdict != DS18B20_CHECK_OK) return false;
+  _recordHealth(addr, DS18B20_HEALTH_OK);
+  return true;
+}
+
+/**
+// _readChecked(): Read Scratchpad with the CRC checked on the fly. Records no presence and
+// complete reads failing the CRC; successful and aborted reads are left to the caller, which
+// records exactly one outcome per read. Returns false without presence.
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_readChecked(const uint8_t addr[8], uint8_t buffer[9], uint8_t &verdict) {
+  DS18B20_MEASURE(DS18B20_LAT_READ_SCRATCHPAD);
+  DS18B20_Script script;
+  _address(script.reset(), addr).write(0xBE).readChecked();  // Read Scratchpad, CRC on the fly
+  uint8_t rx[10];
+  if (!_bus.execute(script, rx)) {
+    _recordHealth(addr, DS18B20_HEALTH_NO_PRESENCE);
+    return false;
+  }
+  memcpy(buffer, rx, 9);
+  verdict = rx[9];
+  if (verdict == DS18B20_CHECK_CRC) _recordHealth(addr, DS18B20_HEALTH_CRC);
+  return true;
+}
+
+/**
+// _classifyChecked(): classifyScratchpad() of a checked read. An aborted read repeats its last
+// byte instead of the CRC, so a failing CRC there means the invalid pattern that stopped it.
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::_classifyChecked(const uint8_t sp[9], uint8_t verdict) {
+  uint8_t status = classifyScratchpad(sp);
+  if (verdict == DS18B20_CHECK_ABORTED && status == DS18B20_STATUS_CRC_ERROR) status = DS18B20_STATUS_INVALID;
+  return status;
+}
+
+/**
+// _recordRead(): health event of a classified scratchpad (all 0xFF counts as a CRC error)
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_recordRead(const uint8_t addr[8], uint8_t status) {
+  uint8_t event = DS18B20_HEALTH_SENTINEL;  // power-on value, bus held low, impossible bytes
+  if (status == DS18B20_STATUS_OK) event = DS18B20_HEALTH_OK;
+  else if (status == DS18B20_STATUS_CRC_ERROR || status == DS18B20_STATUS_DISCONNECTED) event = DS18B20_HEALTH_CRC;
+  _recordHealth(addr, event);
+}
+
+/**
+// writeScratchpad(): write TH,Tl,config into scratchpad (3 bytes)
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::writeScratchpad(const uint8_t addr[8], int8_t th, int8_t tl, uint8_t config) {
+  // no immediate CRC check possible for scratchpad write; read back in the same script to confirm
+  DS18B20_Script script;
+  _address(script.reset(), addr).write(0x4E).write((uint8_t)th).write((uint8_t)tl).write(config);  // Write Scratchpad
+  if (Config::verifyWrites) _address(script.reset(), addr).write(0xBE).readChecked();
+  uint8_t sp[10];
+  if (!_bus.execute(script, sp)) {
+    _recordHealth(addr, DS18B20_HEALTH_NO_PRESENCE);
+    return false;
+  }
+  if (Config::verifyWrites) {
+    if (sp[9] != DS18B20_CHECK_OK) {
+      _recordHealth(addr, DS18B20_HEALTH_CRC);
+      return false;
+    }
+    // Verify match of bytes 2-4 in scratchpad
+    if (sp[2] != (uint8_t)th || sp[3] != (uint8_t)tl || sp[4] != (uint8_t)config) {
+      _recordHealth(addr, DS18B20_HEALTH_VERIFY);
+      return false;
+    }
+    _recordHealth(addr, DS18B20_HEALTH_OK);
+  }
+  // keep the device table in step (conversion timing uses the cached resolution)
+  int16_t idx = indexOf(addr);
+  if (idx >= 0 && (_flags[idx] & DS18B20_FLAG_VALID)) _storeMetadata(idx, _configToResolution(config), th, tl);
+  return true;
+}
+
+/**
+// copyScratchpad(): copy scratchpad to EEPROM (command 0x48). If parasite, master must provide strong pull-up.
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::copyScratchpad(const uint8_t addr[8]) {
+  DS18B20_MEASURE(DS18B20_LAT_COPY_SCRATCHPAD);
+  if (!Config::eeprom) return false;
+  if (_convPending) _waitConversion();
+  // If parasite-powered, strong pullup for the copy time (up to 10ms)
+  bool external = _isExternalPowered(addr);
+  DS18B20_Script script;
+  _address(script.reset(), addr).write(0x48);  // Copy Scratchpad
+  if (!_bus.execute(script, nullptr)) return false;
+  _armConversion(11, !external);
+  _waitConversion();
+  // Optionally read scratchpad to confirm copy (recallE2 does that)
+  return true;
+}
+
+/**
+// recallE2(): recall EEPROM into scratchpad (0xB8)
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::recallE2(const uint8_t addr[8]) {
+  // After recall, read scratchpad
+  if (!Config::eeprom) return false;
+  DS18B20_Script script;
+  _address(script.reset(), addr).write(0xB8);  // Recall E2
+  _address(script.reset(), addr).write(0xBE).readChecked();
+  uint8_t sp[10];
+  if (!_bus.execute(script, sp)) return false;
+  return sp[9] == DS18B20_CHECK_OK;
+}
+
+/**
+// checkBusPower(): Skip ROM + Read Power Supply; any parasite device pulls the time slot low
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::checkBusPower() {
+  if (!Config::parasite) return false;
+  if (!_bus.reset()) return _busParasite;  // no presence, keep previous state
+  _bus.skip();
+  _bus.write(0xB4);  // Read Power Supply (broadcast)
+  _busParasite = (_bus.readBit() == 0);
+  return _busParasite;
+}
+
+/**
+// hasParasiteDevices(): cached bus-level power check
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::hasParasiteDevices() {
+  return _busParasite;
+}
+
+/**
+// convertAll(): broadcast Convert T (0x44), strong pull-up only when the bus needs it
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::convertAll() {
+  if (_convPending) _waitConversion();
+  if (!startConversionAll()) return false;
+  _waitConversion();
+  return true;
+}
+
+/**
+// readPowerSupply(): issue Read Power Supply (0xB4). returns externalPowered in parameter.
+// If the device returns 1 => external power, 0 => parasite.
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::readPowerSupply(const uint8_t addr[8], bool &externalPowered) {
+  _bus.reset();
+  if (Config::maxDevices == 1) _bus.skip();
+  else _bus.select(addr);
+  _bus.write(0xB4);         // Read Power Supply
+  uint8_t v = _bus.readBit();  // read one bit/time slot
+  // parasite devices pull the slot low; a full byte read would return 0xFF for external devices
+  externalPowered = (v != 0);
+  return true;
+}
+
+/**
+// startConversion(): Match ROM Convert T; resolution and power mode are resolved before the command
+// so the strong pull-up follows the last bit without further bus traffic
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::startConversion(const uint8_t addr[8]) {
+  if (_convPending && !isConversionComplete()) return false;
+  uint8_t res = _cachedResolution(addr);  // constant with a fixed resolution
+  bool external = _isExternalPowered(addr);
+  DS18B20_Script script;
+  _address(script.reset(), addr).write(0x44);  // Convert T, strong pull-up handled by the pin
+  if (!_bus.execute(script, nullptr)) return false;
+  _armConversion(_Res::delayMs(res), !external);
+  return true;
+}
+
+/**
+// startConversionAll(): broadcast Convert T (0x44), strong pull-up only when the bus needs it
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::startConversionAll() {
+  if (_convPending && !isConversionComplete()) return false;
+  DS18B20_Script script;
+  script.reset().skip().write(0x44);
+  if (!_bus.execute(script, nullptr)) return false;
+  _armConversion(_sweepDelayMs(), _busParasite);
+  return true;
+}
+
+/**
+// isConversionComplete(): deadline check; releases the pull-up and clears the pending state
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::isConversionComplete() {
+  if (!_convPending) return true;
+  if ((uint32_t)(micros() - _convStart) < _convUs) return false;
+  servicePullup();
+  // the release itself may have happened in an ISR; it is traced here, on the main line
+  if (_pullupTraced && _trace) _trace->record(DS18B20_TRACE_PULLUP, 0);
+  _pullupTraced = false;
+  _convPending = false;
+  return true;
+}
+
+/**
+// servicePullup(): switch the strong pull-up off once the deadline has passed (ISR-safe)
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::servicePullup() {
+  if (!_pullupOn) return;
+  if ((uint32_t)(micros() - _convStart) < _convUs) return;
+  _pullupOn = false;
+  _strongPullup(false);
+}
+
+/**
+// onEvent(): take the first free callback slot
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::onEvent(uint8_t events, DS18B20_EventCallback callback, void *ctx) {
+  if (!callback) return false;
+  for (uint8_t i = 0; i < DS18B20_MAX_CALLBACKS; i++) {
+    if (_listeners[i].callback) continue;
+    _listeners[i].callback = callback;
+    _listeners[i].ctx = ctx;
+    _listeners[i].events = events;
+    return true;
+  }
+  return false;
+}
+
+/**
+// removeEventHandler(): clear matching slots
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::removeEventHandler(DS18B20_EventCallback callback) {
+  for (uint8_t i = 0; i < DS18B20_MAX_CALLBACKS; i++) {
+    if (_listeners[i].callback == callback) _listeners[i].callback = nullptr;
+  }
+}
+
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::setSweepInterval(uint32_t ms) {
+  _sweepInterval = ms;
+}
+
+#if DS18B20_SCHEDULER
+/**
+// setSchedule(): period / priority of one table entry; the device is due right away
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::setSchedule(uint8_t index, uint32_t periodMs, uint8_t priority) {
+  if (index >= _devices) return false;
+  _period[index] = periodMs;
+  _priority[index] = priority;
+  _deadline[index] = millis();
+  return true;
+}
+#endif
+
+#if DS18B20_PIPELINE
+/**
+// setPipelined(): (re)start both groups from scratch; a running sweep finishes first
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::setPipelined(bool on) {
+  _pipelined = on;
+  _pipeBusy = 0;
+  _pipeStart[0] = _pipeStart[1] = millis() - _sweepInterval;  // both groups due right away
+  if (_sweepState != DS18B20_SWEEP_IDLE) return;  // its DUE / RECONVERT flags are still in use
+  for (uint8_t i = 0; i < _devices; i++) _flags[i] &= (uint8_t)~(DS18B20_FLAG_DUE | DS18B20_FLAG_RECONVERT);
+}
+#endif
+
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::setRescanInterval(uint16_t sweeps) {
+  _rescanSweeps = sweeps;
+  _sweepCount = 0;
+}
+
+/**
+// poll(): idle -> Convert T of the due devices -> read them -> re-convert power-on devices one by
+// one -> (rescan) -> idle
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::poll() {
+  servicePullup();
+  if (_sweepState != DS18B20_SWEEP_IDLE) {
+    if (!isConversionComplete()) return;
+    if (_sweepState == DS18B20_SWEEP_CONVERTING) {
+      _readSweep();
+    } else {
+      // still 85 °C after a fresh conversion: a genuine reading
+      int16_t raw;
+      uint8_t buf[8];
+      uint8_t status = _readClassified(_rom(_reconvertIndex, buf), raw);
+      if (status == DS18B20_STATUS_POWER_ON_RESET) status = DS18B20_STATUS_OK;
+      _deliverReading(_reconvertIndex, status, raw);
+    }
+    if (_startReconvert()) return;
+    _sweepState = DS18B20_SWEEP_IDLE;
+    if (_rescanSweeps && ++_sweepCount >= _rescanSweeps) {
+      _sweepCount = 0;
+      rescanDevices();
+    }
+    return;
+  }
+#if DS18B20_PIPELINE
+  if (_pipelined && !_busParasite && _devices > 1) {
+    _pollPipeline();
+    return;
+  }
+#endif
+  uint8_t single = 0;
+  uint8_t due = _collectDue(single);
+  if (!due) return;
+  // a lone device converts by itself, a group shares one broadcast Convert T
+  uint8_t buf[8];
+  bool started = (due == 1 && _devices > 1) ? startConversion(_rom(single, buf)) : startConversionAll();
+  if (started) {
+    _sweepState = DS18B20_SWEEP_CONVERTING;
+    return;
+  }
+  for (uint8_t i = 0; i < _devices; i++) {
+    if (!(_flags[i] & DS18B20_FLAG_DUE)) continue;
+    _flags[i] &= (uint8_t)~DS18B20_FLAG_DUE;
+    _emit(DS18B20_EVENT_ERROR, i, DS18B20_STATUS_NO_PRESENCE, 0);
+  }
+}
+
+#if DS18B20_FILTERS
+/**
+// setFilter(): configure the filter stage of one table entry (clears its history)
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::setFilter(uint8_t index, uint8_t mode, uint8_t alphaQ8, uint16_t maxDelta) {
+  if (index >= _devices) return false;
+  _filter[index].configure(mode, alphaQ8, maxDelta);
+  return true;
+}
+#endif
+
+#if DS18B20_HEALTH
+/**
+// getHealth(): copy the counters of one table entry
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::getHealth(uint8_t index, DS18B20_Health &health) {
+  if (index >= _devices) return false;
+  health = _health[index];
+  return true;
+}
+
+/**
+// worstDevices(): insertion sort of the failing devices by decayed error rate
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::worstDevices(uint8_t *indices, uint8_t max) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < _devices; i++) {
+    uint16_t rate = _health[i].errorRate;
+    if (rate == 0) continue;
+    uint8_t j = (n < max) ? n++ : n;
+    for (; j > 0 && _health[indices[j - 1]].errorRate < rate; j--) {
+      if (j < max) indices[j] = indices[j - 1];
+    }
+    if (j < max) indices[j] = i;
+  }
+  return n;
+}
+
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::clearHealth() {
+  memset(_health, 0, sizeof(_health));
+}
+#endif
+
+#if DS18B20_LATENCY
+/**
+// getLatency(): copy one operation's histogram
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::getLatency(uint8_t op, DS18B20_Histogram &histogram) {
+  if (op >= DS18B20_LAT_COUNT) return false;
+  histogram = _latency[op];
+  return true;
+}
+
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::clearLatency() {
+  memset(_latency, 0, sizeof(_latency));
+}
+#endif
+
+/**
+// rescanDevices(): new ROMs are staged behind the table so indexOf() keeps working during the
+// search; unseen entries are confirmed missing, reported and removed before new ones are merged
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::rescanDevices() {
+  for (uint8_t i = 0; i < _devices; i++) _flags[i] &= (uint8_t)~(DS18B20_FLAG_SEEN | DS18B20_FLAG_NEW);
+  uint8_t added = 0;
+  uint8_t rom[8];
+  for (bool first = true; _nextRom(rom, first); first = false) {
+    if (crc8(rom, 7) != rom[7]) {
+#if DS18B20_HEALTH
+      _searchErrors++;
+#endif
+      continue;
+    }
+    int16_t idx = indexOf(rom);
+    if (idx >= 0) {
+      _flags[idx] |= DS18B20_FLAG_SEEN;
+    } else if (_devices + added < Config::maxDevices) {
+      _setRom(_devices + added, rom);
+      added++;
+    }
+  }
+  _bus.resetSearch();
+
+  bool changed = (added > 0);
+  uint8_t sp[9];
+  for (uint8_t i = 0; i < _devices;) {
+    // a search disturbed by noise can miss a device; only drop it if it does not answer either
+    if ((_flags[i] & DS18B20_FLAG_SEEN) || readScratchpad(_rom(i, rom), sp)) {
+      _flags[i] &= (uint8_t)~DS18B20_FLAG_SEEN;
+      i++;
+      continue;
+    }
+    _emit(DS18B20_EVENT_REMOVED, i, DS18B20_STATUS_NO_PRESENCE, 0);
+    _removeEntry(i, _devices + added);  // staged new ROMs move down with the rest of the table
+    changed = true;
+  }
+
+  for (uint8_t k = 0; k < added; k++) {
+    _cacheMetadata(_devices);
+#if DS18B20_FILTERS
+    _filter[_devices].configure(DS18B20_FILTER_NONE, 0, 0);
+#endif
+#if DS18B20_HEALTH
+    memset(&_health[_devices], 0, sizeof(DS18B20_Health));
+#endif
+#if DS18B20_SCHEDULER
+    _period[_devices] = 0;
+    _priority[_devices] = 0;
+    _deadline[_devices] = millis();
+#endif
+    _flags[_devices] |= DS18B20_FLAG_NEW;
+    _devices++;
+  }
+  if (!changed) return _devices;
+  _sortTable();
+  _buildTagIndex();
+  for (uint8_t i = 0; i < _devices; i++) {
+    if (!(_flags[i] & DS18B20_FLAG_NEW)) continue;
+    _flags[i] &= (uint8_t)~DS18B20_FLAG_NEW;
+    _emit(DS18B20_EVENT_ADDED, i, DS18B20_STATUS_OK, 0);
+  }
+#if DS18B20_PIPELINE
+  if (_pipelined) setPipelined(true);  // entries may have moved between the groups
+#endif
+  if (_cacheStore) saveCache();
+  return _devices;
+}
+
+/**
+// ROM64 variants: unpack the ROM and forward to the address[8] versions
+**/
+template <class Bus, class Config>
+float DS18B20_Driver<Bus, Config>::readTemperature(uint64_t rom64) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return readTemperature(addr);
+}
+
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::readRawTemperature(uint64_t rom64, int16_t &raw) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return readRawTemperature(addr, raw);
+}
+
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::setResolution(uint64_t rom64, uint8_t resolution, bool persistToEeprom) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return setResolution(addr, resolution, persistToEeprom);
+}
+
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::getResolution(uint64_t rom64) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return getResolution(addr);
+}
+
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::setAlarms(uint64_t rom64, int8_t th, int8_t tl, bool persistToEeprom) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return setAlarms(addr, th, tl, persistToEeprom);
+}
+
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::getAlarms(uint64_t rom64, int8_t &th, int8_t &tl) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return getAlarms(addr, th, tl);
+}
+
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::isParasitePower(uint64_t rom64) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return isParasitePower(addr);
+}
+
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::verifyPresence(uint64_t rom64) {
+  uint8_t addr[8];
+  fromROM64(rom64, addr);
+  return verifyPresence(addr);
+}
+
+/**
+// _strongPullup(): control strong pullup MOSFET pin (active HIGH). Not traced: servicePullup()
+// may call it from an ISR while the main line records into the same trace.
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_strongPullup(bool on) {
+  _strongPullupPin.write(on);
+}
+
+/**
+// _armConversion(): start the deadline; pull-up goes on first so it is within the 10us window
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_armConversion(uint16_t ms, bool pullup) {
+  pullup = pullup && _strongPullupPin.pin() >= 0;
+  if (pullup) _strongPullup(true);
+  _convStart = micros();
+  _convUs = (uint32_t)ms * 1000UL;
+  _pullupOn = pullup;
+  _pullupTraced = pullup;
+  if (_trace) {
+    if (pullup) _trace->record(DS18B20_TRACE_PULLUP, 1);
+    _trace->record(DS18B20_TRACE_WAIT, ms);
+  }
+  _convPending = true;
+}
+
+/**
+// _waitConversion(): blocking wrapper around the deadline, yields like delay() does
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_waitConversion() {
+  while (!isConversionComplete()) yield();
+}
+
+/**
+// _cachedResolution(): resolution from the device table, scratchpad read if not cached
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::_cachedResolution(const uint8_t addr[8]) {
+  if (Config::resolution) return Config::resolution;
+  int16_t idx = indexOf(addr);
+  if (idx >= 0 && (_flags[idx] & DS18B20_FLAG_VALID)) return _resolution[idx];
+  return getResolution(addr);
+}
+
+/**
+// _readClassified(): latched temperature with sentinel classification; returns DS18B20_STATUS_*
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::_readClassified(const uint8_t addr[8], int16_t &raw) {
+  uint8_t sp[9];
+  uint8_t verdict = DS18B20_CHECK_CRC;
+  memset(sp, 0xFF, sizeof(sp));  // no presence reads like a floating bus
+  bool present = _readChecked(addr, sp, verdict);
+  uint8_t status = _classifyChecked(sp, verdict);
+  // no presence and complete CRC failures are already counted; one event for everything else
+  if (present && verdict != DS18B20_CHECK_CRC) _recordRead(addr, status);
+  raw = (int16_t)((sp[1] << 8) | sp[0]);
+  return status;
+}
+
+/**
+// _collectDue(): flag the members of the next conversion (DS18B20_FLAG_DUE) and advance their
+// deadlines. Returns the number of members; 'single' is one of them.
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::_collectDue(uint8_t &single) {
+  uint32_t now = millis();
+#if DS18B20_SCHEDULER
+  // earliest deadline first: nothing starts before a deadline has passed ...
+  bool late = false;
+  for (uint8_t i = 0; i < _devices; i++) {
+    if (_period[i] != DS18B20_SCHEDULE_OFF && (int32_t)(now - _deadline[i]) >= 0) late = true;
+  }
+  if (!late) return 0;
+  // ... then devices due before the conversion would complete share it instead of waiting for
+  // a conversion of their own
+  int32_t window = (int32_t)_sweepDelayMs();
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < _devices; i++) {
+    if (_period[i] == DS18B20_SCHEDULE_OFF || (int32_t)(_deadline[i] - now) > window) continue;
+    _advanceDeadline(i, now);
+    _flags[i] |= DS18B20_FLAG_DUE;
+    single = i;
+    n++;
+  }
+  return n;
+#else
+  if ((uint32_t)(now - _lastSweep) < _sweepInterval) return 0;
+  _lastSweep = now;
+  for (uint8_t i = 0; i < _devices; i++) _flags[i] |= DS18B20_FLAG_DUE;
+  single = 0;
+  return _devices;
+#endif
+}
+
+#if DS18B20_SCHEDULER
+/**
+// _advanceDeadline(): next deadline of a device joining a conversion now
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_advanceDeadline(uint8_t index, uint32_t now) {
+  uint32_t period = _period[index] ? _period[index] : _sweepInterval;
+  _deadline[index] += period;  // keep the phase
+  if ((int32_t)(now - _deadline[index]) >= 0) _deadline[index] = now + period;  // fell behind
+}
+#endif
+
+/**
+// _sweepDelayMs(): conversion time of the slowest cached resolution (12 bits for unknown ones)
+**/
+template <class Bus, class Config>
+uint16_t DS18B20_Driver<Bus, Config>::_sweepDelayMs() {
+  uint8_t res = 0;
+  for (uint8_t i = 0; i < _devices; i++) {
+    uint8_t r = _tableResolution(i);
+    if (r > res) res = r;
+  }
+  return _Res::delayMs(res);
+}
+
+/**
+// _directedSearch(): Search ROM (0xF0) steering every triplet towards rom's bit. Returns the first
+// bit (0..63) where no device has that value, 64 if the whole ROM answered.
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::_directedSearch(const uint8_t rom[8]) {
+  if (_convPending) _waitConversion();  // the search would interrupt a parasite conversion
+  if (!_bus.reset()) return 0;
+  _bus.write(0xF0);
+  for (uint8_t bit = 0; bit < 64; bit++) {
+    uint8_t want = (rom[bit >> 3] >> (bit & 0x07)) & 0x01;
+    uint8_t t = _bus.triplet(want);
+    // id bit 0: some device has a 0 here; complement bit 0: some device has a 1
+    uint8_t nobody = want ? (t & 0x02) : (t & 0x01);
+    if (nobody) return bit;
+  }
+  return 64;
+}
+
+/**
+// _readSweep(): read the devices of the finished conversion (table entries first, first + step,
+// ...), highest priority first; power-on values are held back and re-converted individually
+// instead of repeating the sweep
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_readSweep(uint8_t first, uint8_t step) {
+  uint8_t buf[8];
+  for (;;) {
+    int16_t next = -1;
+    for (uint8_t i = first; i < _devices; i += step) {
+      if (!(_flags[i] & DS18B20_FLAG_DUE)) continue;
+#if DS18B20_SCHEDULER
+      if (next < 0 || _priority[i] > _priority[next]) next = i;
+#else
+      next = i;
+      break;
+#endif
+    }
+    if (next < 0) return;
+    uint8_t i = (uint8_t)next;
+    _flags[i] &= (uint8_t)~DS18B20_FLAG_DUE;
+    int16_t raw;
+    uint8_t status = _readClassified(_rom(i, buf), raw);
+    if (status == DS18B20_STATUS_POWER_ON_RESET) {
+      // the pipeline re-converts with the group; the flag survives until the next reading
+      if (!(_flags[i] & DS18B20_FLAG_RECONVERT)) {
+        _flags[i] |= DS18B20_FLAG_RECONVERT;
+        continue;
+      }
+      status = DS18B20_STATUS_OK;  // still 85 °C after a fresh conversion
+    }
+    _flags[i] &= (uint8_t)~DS18B20_FLAG_RECONVERT;
+    _deliverReading(i, status, raw);
+  }
+}
+
+#if DS18B20_PIPELINE
+/**
+// _pollPipeline(): service the groups in turn: once a group's conversion is complete, read it
+// and restart it as soon as a member is due while the other group keeps converting; at most one
+// group is started per call
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_pollPipeline() {
+  uint32_t now = millis();
+  for (uint8_t g = 0; g < 2; g++) {
+    if (_pipeBusy & (1 << g)) {
+      if ((uint32_t)(now - _pipeStart[g]) < _pipeMs[g]) continue;
+      _pipeBusy &= (uint8_t)~(1 << g);
+      _readSweep(g, 2);
+      if (g == 0 && _rescanSweeps && ++_sweepCount >= _rescanSweeps) {
+        _sweepCount = 0;
+        rescanDevices();
+      }
+    }
+    if (_startGroup(g)) return;
+  }
+}
+
+/**
+// _startGroup(): Match ROM Convert T for the due members of a group, chosen by the same
+// deadlines as _collectDue(); members held back for a re-conversion always join. The group
+// completes with its slowest member. Returns false if nothing was due.
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_startGroup(uint8_t group) {
+  uint32_t now = millis();
+#if DS18B20_SCHEDULER
+  bool late = false;
+  for (uint8_t i = group; i < _devices; i += 2) {
+    if (_flags[i] & DS18B20_FLAG_RECONVERT) late = true;
+    if (_period[i] != DS18B20_SCHEDULE_OFF && (int32_t)(now - _deadline[i]) >= 0) late = true;
+  }
+  if (!late) return false;
+  int32_t window = (int32_t)_sweepDelayMs();
+#else
+  if ((uint32_t)(now - _pipeStart[group]) < _sweepInterval) return false;
+#endif
+  uint8_t buf[8];
+  uint8_t res = 0;
+  for (uint8_t i = group; i < _devices; i += 2) {
+#if DS18B20_SCHEDULER
+    if (!(_flags[i] & DS18B20_FLAG_RECONVERT)) {
+      if (_period[i] == DS18B20_SCHEDULE_OFF || (int32_t)(_deadline[i] - now) > window) continue;
+      _advanceDeadline(i, now);
+    }
+#endif
+    DS18B20_Script script;
+    _address(script.reset(), _rom(i, buf)).write(0x44);  // Convert T
+    if (!_bus.execute(script, nullptr)) {
+      _emit(DS18B20_EVENT_ERROR, i, DS18B20_STATUS_NO_PRESENCE, 0);
+      continue;
+    }
+    _flags[i] |= DS18B20_FLAG_DUE;
+    uint8_t r = _tableResolution(i);
+    if (r > res) res = r;
+  }
+  _pipeStart[group] = millis();
+  _pipeMs[group] = _Res::delayMs(res);
+  _pipeBusy |= (uint8_t)(1 << group);
+  return true;
+}
+#endif
+
+/**
+// _deliverReading(): READING (+ ALARM) for good values, ERROR otherwise
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_deliverReading(uint8_t index, uint8_t status, int16_t raw) {
+  if (status != DS18B20_STATUS_OK) {
+    _emit(DS18B20_EVENT_ERROR, index, status, 0);
+    return;
+  }
+#if DS18B20_FILTERS
+  if (!_filter[index].apply(raw)) {
+    _emit(DS18B20_EVENT_ERROR, index, DS18B20_STATUS_SPIKE, raw);
+    return;
+  }
+#endif
+  _emit(DS18B20_EVENT_READING, index, status, raw);
+  // same rule as the device's alarm flag: integer part at or beyond TH / TL (a tag in tag mode)
+  int8_t t = (int8_t)(raw >> 4);
+  if (Config::alarms && !_tagMode && (_flags[index] & DS18B20_FLAG_VALID) && (t >= _th[index] || t <= _tl[index])) _emit(DS18B20_EVENT_ALARM, index, status, raw);
+}
+
+/**
+// _startReconvert(): Match ROM Convert T for the next device flagged in this sweep
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_startReconvert() {
+  uint8_t buf[8];
+  for (uint8_t i = 0; i < _devices; i++) {
+    if (!(_flags[i] & DS18B20_FLAG_RECONVERT)) continue;
+    _flags[i] &= (uint8_t)~DS18B20_FLAG_RECONVERT;
+    const uint8_t *addr = _rom(i, buf);
+    _recordHealth(addr, DS18B20_HEALTH_RETRY);
+    if (!startConversion(addr)) {
+      _emit(DS18B20_EVENT_ERROR, i, DS18B20_STATUS_NO_PRESENCE, 0);
+      continue;
+    }
+    _reconvertIndex = i;
+    _sweepState = DS18B20_SWEEP_RECONVERTING;
+    return true;
+  }
+  return false;
+}
+
+/**
+// _emit(): deliver one event to every slot subscribed to its type
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_emit(uint8_t type, uint8_t index, uint8_t status, int16_t raw) {
+  DS18B20_Event event;
+  event.type = type;
+  event.index = index;
+  event.status = status;
+  event.raw = raw;
+  event.timestamp = millis();
+  for (uint8_t i = 0; i < DS18B20_MAX_CALLBACKS; i++) {
+    if (_listeners[i].callback && (_listeners[i].events & type)) _listeners[i].callback(event, _listeners[i].ctx);
+  }
+}
+
+/**
+// _removeEntry(): drop table entry 'index'; the following entries up to 'used' move down
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_removeEntry(uint8_t index, uint8_t used) {
+  for (uint8_t i = index; i + 1 < used; i++) _swapEntries(i, i + 1);
+  _devices--;
+}
+
+/**
+// _recordHealth(): count one transaction outcome for the table entry of 'addr' (if any)
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_recordHealth(const uint8_t addr[8], uint8_t event) {
+#if DS18B20_HEALTH
+  int16_t idx = indexOf(addr);
+  if (idx < 0) return;
+  DS18B20_Health &h = _health[idx];
+  uint16_t *counter = nullptr;
+  switch (event) {
+    case DS18B20_HEALTH_CRC: counter = &h.crcErrors; break;
+    case DS18B20_HEALTH_NO_PRESENCE: counter = &h.noPresence; break;
+    case DS18B20_HEALTH_VERIFY: counter = &h.verifyErrors; break;
+    case DS18B20_HEALTH_SENTINEL: counter = &h.sentinels; break;
+    case DS18B20_HEALTH_RETRY:
+      if (h.retries != 0xFFFF) h.retries++;
+      return;  // a retry is not a transaction outcome
+  }
+  if (counter && *counter != 0xFFFF) (*counter)++;
+  // exponential decay towards 65535 on errors, towards 0 on success
+  int32_t target = counter ? 65535 : 0;
+  h.errorRate = (uint16_t)(h.errorRate + ((target - (int32_t)h.errorRate) >> 4));
+#else
+  (void)addr;
+  (void)event;
+#endif
+}
+
+/**
+// _sortTable(): insertion sort of the device table (with metadata) by ROM64
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_sortTable() {
+  if (Config::maxDevices == 1) return;
+  uint8_t a[8], b[8];
+  for (uint8_t i = 1; i < _devices; i++) {
+    for (uint8_t j = i; j > 0 && _compareROM(_rom(j - 1, a), _rom(j, b)) > 0; j--) {
+      _swapEntries(j - 1, j);
+    }
+  }
+}
+
+/**
+// _swapEntries(): swap two device table entries including their metadata
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_swapEntries(uint8_t a, uint8_t b) {
+  uint8_t tmp[_ROM_BYTES];
+  memcpy(tmp, _addresses[a], _ROM_BYTES);
+  memcpy(_addresses[a], _addresses[b], _ROM_BYTES);
+  memcpy(_addresses[b], tmp, _ROM_BYTES);
+  if (!Config::resolution) {
+    uint8_t r = _resolution[a];
+    _resolution[a] = _resolution[b];
+    _resolution[b] = r;
+  }
+  if (Config::alarms) {
+    int8_t t = _th[a];
+    _th[a] = _th[b];
+    _th[b] = t;
+    t = _tl[a];
+    _tl[a] = _tl[b];
+    _tl[b] = t;
+  }
+  uint8_t f = _flags[a];
+  _flags[a] = _flags[b];
+  _flags[b] = f;
+#if DS18B20_FILTERS
+  DS18B20_Filter filter = _filter[a];
+  _filter[a] = _filter[b];
+  _filter[b] = filter;
+#endif
+#if DS18B20_HEALTH
+  DS18B20_Health health = _health[a];
+  _health[a] = _health[b];
+  _health[b] = health;
+#endif
+#if DS18B20_SCHEDULER
+  uint32_t v = _period[a];
+  _period[a] = _period[b];
+  _period[b] = v;
+  v = _deadline[a];
+  _deadline[a] = _deadline[b];
+  _deadline[b] = v;
+  f = _priority[a];
+  _priority[a] = _priority[b];
+  _priority[b] = f;
+#endif
+}
+
+/**
+// _address(): Match ROM, or Skip ROM when the configuration has a single device
+**/
+template <class Bus, class Config>
+DS18B20_Script &DS18B20_Driver<Bus, Config>::_address(DS18B20_Script &script, const uint8_t addr[8]) {
+  if (Config::maxDevices == 1) return script.skip();
+  return script.match(addr);
+}
+
+/**
+// _nextRom(): next ROM of a search started with first = true; single-device configurations read
+// the ROM with Read ROM (0x33) instead of running the search algorithm
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_nextRom(uint8_t rom[8], bool first) {
+  if (Config::maxDevices == 1) {
+    if (!first) return false;
+    DS18B20_Script script;
+    script.reset().write(0x33).read(8);  // Read ROM
+    return _bus.execute(script, rom) && rom[0] != 0x00;  // all zero (bus held low) passes the CRC
+  }
+  if (first) _bus.resetSearch();
+  return _bus.search(rom);
+}
+
+/**
+// _rom(): ROM of table entry 'index'; compact tables rebuild it (CRC recomputed) in 'buf'
+**/
+template <class Bus, class Config>
+const uint8_t *DS18B20_Driver<Bus, Config>::_rom(uint8_t index, uint8_t buf[8]) {
+  if (!Config::compactRom) return _addresses[index];
+  memcpy(buf, _addresses[index], 7);
+  buf[7] = crc8(buf, 7);
+  return buf;
+}
+
+/**
+// _copyRom(): full ROM of table entry 'index' into rom[8]
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_copyRom(uint8_t index, uint8_t rom[8]) {
+  memcpy(rom, _addresses[index], _ROM_BYTES);
+  if (Config::compactRom) rom[7] = crc8(rom, 7);
+}
+
+/**
+// _setRom(): store a CRC-checked ROM in table entry 'index' (without the CRC byte if compact)
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_setRom(uint8_t index, const uint8_t rom[8]) {
+  memcpy(_addresses[index], rom, _ROM_BYTES);
+}
+
+/**
+// _tableResolution(): cached resolution of table entry 'index' (the fixed one if configured)
+**/
+template <class Bus, class Config>
+uint8_t DS18B20_Driver<Bus, Config>::_tableResolution(uint8_t index) {
+  if (Config::resolution) return Config::resolution;
+  return _resolution[index];
+}
+
+/**
+// _storeMetadata(): update the resolution / TH / TL columns that the configuration keeps
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_storeMetadata(uint8_t index, uint8_t resolution, int8_t th, int8_t tl) {
+  if (!Config::resolution) _resolution[index] = resolution;
+  if (Config::alarms) {
+    _th[index] = th;
+    _tl[index] = tl;
+  }
+}
+
+/**
+// _buildTagIndex(): insertion sort of device indices by cached TH/TL tag (tag mode only)
+**/
+template <class Bus, class Config>
+void DS18B20_Driver<Bus, Config>::_buildTagIndex() {
+  if (!_tagMode) return;
+  uint16_t tag, prev;
+  for (uint8_t i = 0; i < _devices; i++) {
+    _tagOrder[i] = i;
+    getTag(i, tag);
+    uint8_t j = i;
+    while (j > 0 && getTag(_tagOrder[j - 1], prev) && prev > tag) {
+      _tagOrder[j] = _tagOrder[j - 1];
+      j--;
+    }
+    _tagOrder[j] = i;
+  }
+}
+
+/**
+// _isExternalPowered(): all devices are external unless the bus check found a parasite device;
+// then use the cached flag of a known device or query the device itself.
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_isExternalPowered(const uint8_t addr[8]) {
+  if (!Config::parasite || !_busParasite) return true;
+  int16_t idx = indexOf(addr);
+  if (idx >= 0 && (_flags[idx] & DS18B20_FLAG_VALID)) return !(_flags[idx] & DS18B20_FLAG_PARASITE);
+  bool external = true;
+  readPowerSupply(addr, external);
+  return external;
+}
+
+/**
+// _cacheMetadata(): read scratchpad and power mode of device 'index' into the device table
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_cacheMetadata(uint8_t index) {
+  uint8_t sp[9];
+  uint8_t buf[8];
+  const uint8_t *addr = _rom(index, buf);
+  _flags[index] = 0;
+  if (!readScratchpad(addr, sp)) return false;
+  _storeMetadata(index, _configToResolution(sp[4]), (int8_t)sp[2], (int8_t)sp[3]);
+  bool external = true;
+  if (Config::parasite && _busParasite) readPowerSupply(addr, external);  // skip per-device query on external-only buses
+  _flags[index] = DS18B20_FLAG_VALID | (external ? 0 : DS18B20_FLAG_PARASITE);
+  return _enforceResolution(index, sp);
+}
+
+/**
+// _verifyCachedDevices(): Match ROM scratchpad read of each cached device; refreshes
+// resolution/TH/TL from the scratchpad. Returns false as soon as one device is missing.
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_verifyCachedDevices() {
+  if (!_bus.reset()) return false;  // no presence pulse at all
+  uint8_t sp[9];
+  uint8_t buf[8];
+  for (uint8_t i = 0; i < _devices; i++) {
+    if (!readScratchpad(_rom(i, buf), sp)) return false;
+    _storeMetadata(i, _configToResolution(sp[4]), (int8_t)sp[2], (int8_t)sp[3]);
+    _flags[i] |= DS18B20_FLAG_VALID;
+    _enforceResolution(i, sp);
+  }
+  _buildTagIndex();
+  return true;
+}
+
+/**
+// _enforceResolution(): reprogram a device found at another resolution than the fixed one; the
+// cached TH/TL bytes are kept and the result persisted if EEPROM support is compiled in
+**/
+template <class Bus, class Config>
+bool DS18B20_Driver<Bus, Config>::_enforceResolution(uint8_t index, const uint8_t sp[9]) {
+  if (!Config::resolution || (sp[4] & 0x60) == (_Res::config(0) & 0x60)) return true;
+  uint8_t buf[8];
+  const uint8_t *addr = _rom(index, buf);
+  if (!writeScratchpad(addr, (int8_t)sp[2], (int8_t)sp[3], _Res::config(0))) return false;
+  return !Config::eeprom || copyScratchpad(addr);
+}
+
+#endif